@@ -1,16 +1,48 @@
 #pragma once
 
+#include "biome/biome_type.hpp"
+#include "biome/column_data.hpp"
+#include "biome/decoration.hpp"
 #include "chunk/chunk.hpp"
+#include "util/rng.hpp"
 
+// Biomes are stateless: BiomeManager::getBiome() hands out one shared const
+// instance per type, used by every generation thread at once.
 class Biome {
 public:
-    void generateTerrain(Chunk& chunk);
-    void fillWater(Chunk& chunk);
+    explicit Biome(BiomeType type) : type(type) {}
+
+    // Random choices draw from `rng`, the chunk's own stream (see Rng).
+    // Each column takes its top block from its own biome.
+    static void generateTerrain(Chunk& chunk, const ColumnData& columns, Rng& rng);
+    void fillWater(Chunk& chunk) const;
     static int getHeight(glm::vec2 pos, float *biome_noise_out = nullptr);
-    virtual BlockType generateInternalBlock(int x, int y, int z);
-    virtual void generateMinerals(Chunk& chunk);
-    virtual BlockType generateTopBlock(int y) = 0;
-    virtual void spawnDecorations(Chunk& chunk) = 0;
+    // Both in [0, 1], independent of the height noise.
+    static float getTemperature(glm::vec2 pos);
+    static float getMoisture(glm::vec2 pos);
+    // Batched getHeight() at `n` world positions (x[i], z[i]).
+    static void sampleHeights(const float *x, const float *z, size_t n,
+                              int *height, float *biome_noise);
+    // Batched getTemperature() and getMoisture().
+    static void sampleClimate(const float *x, const float *z, size_t n,
+                              float *temperature, float *moisture);
+    // Height and biome noise for every column of chunk (cx, cz); `out` is
+    // indexed like ColumnData.
+    static void sampleColumns(int cx, int cz, ColumnSample *out);
+    // Shared by every biome and called per voxel, so deliberately not virtual.
+    static BlockType generateInternalBlock(int y, Rng& rng);
+    void generateMinerals(Chunk& chunk, Rng& rng) const;
+    virtual BlockType generateTopBlock(int y, Rng& rng) const = 0;
+    // Decorates the columns of this biome. Blocks that land outside `chunk`
+    // go to `overflow`.
+    virtual void spawnDecorations(Chunk& chunk, const ColumnData& columns,
+                                  std::vector<DecorationWrite>& overflow,
+                                  Rng& rng) const = 0;
     virtual ~Biome() {}
-};
 
+protected:
+    const BiomeType type;
+    // Mineral noise is sampled every `ore_noise_spacing` blocks and
+    // trilinearly interpolated in between; 1 samples every stone voxel.
+    int ore_noise_spacing = 4;
+};
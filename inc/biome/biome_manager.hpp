@@ -3,10 +3,13 @@
 #include "biome/biome.hpp"
 #include "biome/biome_type.hpp"
 #include <glm/glm.hpp>
-#include <memory>
 
 class BiomeManager {
 public:
-  static std::unique_ptr<Biome> createBiome(BiomeType type);
-  static BiomeType getBiomeForChunk(int cx, int cz);
+  // The shared instance for `type`; safe to use from any thread.
+  static const Biome &getBiome(BiomeType type);
+  // Biome for a point with the given terrain height, biome noise and
+  // climate (see Biome::getHeight/getTemperature/getMoisture).
+  static BiomeType classify(int height, float biome_noise, float temperature,
+                            float moisture);
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "biome/biome_type.hpp"
+#include "chunk/chunk.hpp"
+#include "robin_hood/robin_hood.h"
+#include "util/lock.hpp"
+#include <array>
+#include <memory>
+
+// Biome of every kCellSize x kCellSize block cell, classified once from the
+// height and climate noise at the cell's centre. Cells are cached in square
+// regions shared by every chunk they cover. Each column reads its cell with a
+// small fixed jitter, so biome borders don't trace the cell grid.
+class BiomeMap {
+public:
+  static constexpr int kCellShift = 2;   // 4x4-block cells
+  static constexpr int kRegionShift = 5; // 32x32 cells (8x8 chunks) per region
+  static constexpr int kCellSize = 1 << kCellShift;
+  static constexpr int kRegionCells = 1 << kRegionShift;
+
+  // Biome of every column of chunk (cx, cz), indexed like ColumnData.
+  // Thread-safe.
+  void chunkBiomes(int cx, int cz, BiomeType *out);
+  // Drops cached regions lying entirely beyond `radius` chunks of (cx, cz).
+  void prune(int cx, int cz, int radius);
+
+private:
+  using Region = std::array<BiomeType, kRegionCells * kRegionCells>;
+
+  // Cached region (rx, rz), computed on first use.
+  std::shared_ptr<const Region> region(int rx, int rz);
+  static std::shared_ptr<const Region> computeRegion(int rx, int rz);
+
+  std::mutex mutex;
+  robin_hood::unordered_map<ChunkKey, std::shared_ptr<const Region>, ChunkKeyHash>
+      regions; // by region coordinates
+};
@@ -10,3 +10,5 @@ enum class BiomeType: uint8_t {
   TROPICAL,
   CHERRY
 };
+
+constexpr int kBiomeTypeCount = static_cast<int>(BiomeType::CHERRY) + 1;
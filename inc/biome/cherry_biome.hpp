@@ -7,8 +7,10 @@ class CherryBiome : public Biome {
 public:
   CherryBiome();
   ~CherryBiome() override = default;
-  BlockType generateTopBlock(int y) override;
-  void spawnDecorations(Chunk &chunk) override;
+  BlockType generateTopBlock(int y, Rng &rng) const override;
+  void spawnDecorations(Chunk &chunk, const ColumnData &columns,
+                        std::vector<DecorationWrite> &overflow,
+                        Rng &rng) const override;
 
 private:
   TreeSpawner cherry_tree_spawner;
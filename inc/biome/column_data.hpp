@@ -0,0 +1,31 @@
+#pragma once
+
+#include "biome/biome_type.hpp"
+#include "core/constants.hpp"
+#include <array>
+
+class BiomeMap;
+
+// Surface noise for one column, sampled once per chunk before any block is
+// placed and consumed by every later generation stage.
+struct ColumnSample {
+  int height;        // Biome::getHeight
+  float biome_noise; // plains (0) .. mountains (1)
+  BiomeType biome;   // from the BiomeMap
+};
+
+class ColumnData {
+public:
+  // Samples all kChunkWidth x kChunkDepth columns of chunk (cx, cz).
+  void compute(int cx, int cz, BiomeMap &biomes);
+
+  const ColumnSample &at(int x, int z) const { return columns[x + kChunkWidth * z]; }
+  // Whether any column of the chunk is in `biome`.
+  bool hasBiome(BiomeType biome) const {
+    return present & (1u << static_cast<unsigned>(biome));
+  }
+
+private:
+  std::array<ColumnSample, kChunkWidth * kChunkDepth> columns;
+  uint32_t present = 0; // bit per BiomeType
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "block/block_type.hpp"
+#include <glm/glm.hpp>
+#include <vector>
+
+class Chunk;
+
+// A decoration block that fell outside the chunk that generated it, in world
+// coordinates. The World hands it to the chunk owning that position, now or
+// whenever that chunk is generated.
+struct DecorationWrite {
+  glm::ivec3 pos;
+  BlockType type;
+};
+
+// Decorations from different chunks can overlap, and arrive in any order.
+// Logs beat leaves beat air (ties go to the higher block id) and nothing else
+// is ever replaced, so the result is the same whichever chunk came first.
+bool decorationReplaces(BlockType current, BlockType incoming);
+
+// Where tree generators draw. Coordinates are local to the chunk being
+// decorated but may run past its sides: those blocks go to `overflow`.
+class DecorationCanvas {
+public:
+  DecorationCanvas(Chunk &chunk, std::vector<DecorationWrite> &overflow)
+      : chunk(chunk), overflow(overflow) {}
+
+  // AIR outside the chunk.
+  BlockType at(int x, int y, int z) const;
+  // Places `type` whatever is there (trunks).
+  void set(int x, int y, int z, BlockType type);
+  // Places `type` only into air (foliage).
+  void fill(int x, int y, int z, BlockType type);
+
+private:
+  bool inside(int x, int z) const;
+  void spill(int x, int y, int z, BlockType type);
+
+  Chunk &chunk;
+  std::vector<DecorationWrite> &overflow;
+};
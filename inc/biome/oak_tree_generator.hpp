@@ -2,7 +2,8 @@
 
 #include "tree_generator.hpp"
 
-class OakTreeGenerator : public TreeGenerator {
+class OakTreeGenerator {
 public:
-  void generate(Chunk &chunk, int x, int y, int z) override;
+  static void generate(DecorationCanvas &canvas, Rng &rng, int x, int y,
+                       int z);
 };
@@ -2,7 +2,8 @@
 
 #include "biome/tree_generator.hpp"
 
-class PalmTreeGenerator : public TreeGenerator {
+class PalmTreeGenerator {
 public:
-  void generate(Chunk &chunk, int x, int y, int z) override;
+  static void generate(DecorationCanvas &canvas, Rng &rng, int x, int y,
+                       int z);
 };
@@ -1,9 +1,9 @@
 #pragma once
 
-#include "chunk/chunk.hpp"
+#include "biome/decoration.hpp"
+#include "util/rng.hpp"
 
-class TreeGenerator {
-public:
-  virtual void generate(Chunk &chunk, int x, int y, int z) = 0;
-  virtual ~TreeGenerator() {}
-};
+// Grows one tree. (x, y, z) is the block it stands on, local to the canvas'
+// chunk. Generators are plain functions: they keep no state between trees.
+using TreeGenerator = void (*)(DecorationCanvas &canvas, Rng &rng, int x,
+                               int y, int z);
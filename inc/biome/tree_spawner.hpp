@@ -1,17 +1,25 @@
 #pragma once
 
+#include "biome/biome_type.hpp"
+#include "biome/column_data.hpp"
 #include "biome/tree_generator.hpp"
 #include "chunk/chunk.hpp"
-#include <functional>
-#include <memory>
 
 class TreeSpawner {
 public:
-  TreeSpawner(double density, std::unique_ptr<TreeGenerator> generator);
-  void spawn(Chunk &chunk,
-             std::function<bool(Chunk &, int, int, int)> isValidSpawn);
+  // Whether a tree may stand on local block (x, y, z), the column's surface.
+  using SpawnPredicate = bool (*)(const Chunk &chunk, int x, int y, int z);
+
+  constexpr TreeSpawner(double density, TreeGenerator generator,
+                        SpawnPredicate isValidSpawn)
+      : density(density), generator(generator), isValidSpawn(isValidSpawn) {}
+  // Spawns in the columns of `biome` only. Trees may overhang the chunk;
+  // those blocks are appended to `overflow`.
+  void spawn(Chunk &chunk, const ColumnData &columns, BiomeType biome,
+             std::vector<DecorationWrite> &overflow, Rng &rng) const;
 
 private:
   double density;
-  std::unique_ptr<TreeGenerator> generator;
+  TreeGenerator generator;
+  SpawnPredicate isValidSpawn;
 };
@@ -7,9 +7,10 @@ class TropicalBiome : public Biome {
 public:
   TropicalBiome();
   ~TropicalBiome() override = default;
-  // BlockType generateInternalBlock(int x, int y, int z) override;
-  BlockType generateTopBlock(int y) override;
-  void spawnDecorations(Chunk &chunk) override;
+  BlockType generateTopBlock(int y, Rng &rng) const override;
+  void spawnDecorations(Chunk &chunk, const ColumnData &columns,
+                        std::vector<DecorationWrite> &overflow,
+                        Rng &rng) const override;
 
 private:
   TreeSpawner oak_tree_spawner;
@@ -74,7 +74,8 @@ inline uint8_t skyLightOpacity(BlockType type) {
 }
 
 // Light a block emits on its own, 0 (none) .. 15 (max, like glowstone).
-// Emissive blocks seed the block-light BFS in Chunk::computeBlockLight().
+// Emissive blocks seed the block-light BFS (Chunk::computeBlockLight(),
+// LightEngine).
 inline uint8_t blockLightEmission(BlockType type) {
   switch (type) {
     case BlockType::GLOWSTONE: return 15;
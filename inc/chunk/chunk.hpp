@@ -1,12 +1,18 @@
 #pragma once
 
+#include "biome/decoration.hpp"
 #include "block/block_type.hpp"
 #include "chunk/chunk_mesh.hpp"
+#include "chunk/chunk_section.hpp"
+#include "util/lock.hpp"
 #include <glm/ext/matrix_transform.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <glm/glm.hpp>
-#include <mutex>
 #include <vector>
 
+class BiomeMap;
 class World;
 
 struct ChunkKey {
@@ -22,29 +28,103 @@ struct ChunkKeyHash {
   }
 };
 
+// Per-voxel light is stored packed: sky light (0-15) in the high nibble and
+// block light (0-15) in the low nibble of one byte.
+inline uint8_t packLight(uint8_t sky, uint8_t block) {
+  return static_cast<uint8_t>((sky << 4) | (block & 0x0F));
+}
+inline uint8_t skyLightOf(uint8_t light) { return light >> 4; }
+inline uint8_t blockLightOf(uint8_t light) { return light & 0x0F; }
+
+// Lifecycle of a chunk, in order. Queued through Lit happen inside the
+// generation job; Meshing is claimed once, by whichever chunk completes the
+// 3x3 neighbourhood; Meshed/Uploaded then alternate as the chunk is rebuilt.
+enum class ChunkState : uint8_t {
+  Queued,    // waiting for a generation worker
+  Generated, // terrain, minerals and water placed
+  Decorated, // trees and other decorations placed
+  Lit,       // sky and block light computed; visible to other chunks
+  Meshing,   // first mesh queued (all 8 neighbours at least Lit)
+  Meshed,    // CPU mesh built
+  Uploaded,  // current mesh is on the GPU
+};
+
+// A chunk's blocks and heightmaps without its light or mesh: what the World
+// keeps of a recently unloaded chunk so that reloading it skips generation.
+struct ChunkBlocks {
+  std::array<ChunkSection, kSectionCount> sections;
+  std::array<int16_t, kChunkWidth * kChunkDepth> top_non_air;
+  std::array<int16_t, kChunkWidth * kChunkDepth> top_opaque;
+
+  size_t memoryUsage() const;
+};
+
 class Chunk {
 public:
   Chunk(int x, int z);
   ~Chunk() = default;
 
-  void init();
+  // Generates terrain and decorations (Queued -> Decorated). Decoration
+  // blocks that land in neighbouring chunks are appended to `overflow`.
+  void generate(BiomeMap &biomes, std::vector<DecorationWrite> &overflow);
+  // Lights and compacts a generated chunk (Decorated -> Lit).
+  void finalize();
+  // Both, dropping any overflow.
+  void init(BiomeMap &biomes);
+  // Copies the blocks out (see ChunkBlocks). Caller holds a read lock.
+  ChunkBlocks copyBlocks() const;
+  // Installs blocks copied from an earlier instance of this chunk, in place
+  // of generate() (Queued -> Decorated).
+  void restoreBlocks(ChunkBlocks &&blocks);
   void buildMeshData(World* world, TextureManager& texture_manager);
   void uploadGPU();
+  // Frees the mesh's GL objects. Main thread, once the chunk has left the
+  // map: a worker may drop the last reference later, without a GL context.
+  void releaseGPU() { mesh.release(); }
 
-  BlockType &at(int x, int y, int z);
-  const BlockType &at(int x, int y, int z) const;
+  BlockType at(int x, int y, int z) const;
+  BlockType atLinear(uint32_t index) const; // x + 16 * (z + 16 * y)
   BlockType safeAt(int x, int y, int z) const;
+  void setBlock(int x, int y, int z, BlockType type);
 
   // Overwrite a block by its linear index (used when replaying saved edits).
   void setBlockLinear(uint32_t index, BlockType type);
 
+  // Collapse single-type sections to sentinels and pack the rest into
+  // palette form (when Settings::palette_storage is on). Called once
+  // generation is done; later edits keep sections in their compacted form.
+  void compact();
+  const ChunkSection &getSection(int s) const { return sections[s]; }
+
+  // Heightmap, kept current by every block write: y of the highest non-air
+  // block and of the highest fully opaque block in a column (-1 if none).
+  int topNonAir(int x, int z) const { return top_non_air[x + kChunkWidth * z]; }
+  int topOpaque(int x, int z) const { return top_opaque[x + kChunkWidth * z]; }
+  int maxHeight() const; // highest non-air block in the whole chunk (-1 if empty)
+  // Writes all blocks in linear index order into `out` (kChunkWidth *
+  // kChunkHeight * kChunkDepth entries) — the mesher's fast read path.
+  void decodeBlocks(BlockType *out) const;
+  size_t blockMemoryUsage() const;
+
+  // Packed sky+block light byte (see packLight); safeLight() is 0 outside.
+  uint8_t getLight(int x, int y, int z) const {
+    return light[x + kChunkWidth * (z + kChunkDepth * y)];
+  }
+  uint8_t safeLight(int x, int y, int z) const;
+  const uint8_t *lightData() const { return light.data(); } // linear index order
+  // Replaces light [begin, begin + count) with `data` (linear index order) —
+  // LightEngine commits.
+  void setLightData(const uint8_t *data, uint32_t begin, uint32_t count) {
+    std::copy(data, data + count, light.begin() + begin);
+  }
+
   void computeSkyLight();
-  uint8_t getSkyLight(int x, int y, int z) const;
-  uint8_t safeSkyLight(int x, int y, int z) const;
+  uint8_t getSkyLight(int x, int y, int z) const { return skyLightOf(getLight(x, y, z)); }
+  uint8_t safeSkyLight(int x, int y, int z) const { return skyLightOf(safeLight(x, y, z)); }
 
   void computeBlockLight();
-  uint8_t getBlockLight(int x, int y, int z) const;
-  uint8_t safeBlockLight(int x, int y, int z) const;
+  uint8_t getBlockLight(int x, int y, int z) const { return blockLightOf(getLight(x, y, z)); }
+  uint8_t safeBlockLight(int x, int y, int z) const { return blockLightOf(safeLight(x, y, z)); }
 
   // Emitter bookkeeping (for the cross-chunk relight fast-path gate).
   bool hasEmitters() const { return emitter_count > 0; }
@@ -55,17 +135,61 @@ public:
   // World writes cross-chunk light results back into this chunk).
   void setBlockLightLinear(uint32_t index, uint8_t value);
 
+  ChunkState getState() const { return state.load(std::memory_order_acquire); }
+  // Atomically moves `from` -> `to`; false if another thread got there first.
+  bool advanceState(ChunkState from, ChunkState to) {
+    return state.compare_exchange_strong(from, to, std::memory_order_acq_rel);
+  }
+  void setState(ChunkState s) { state.store(s, std::memory_order_release); }
+
+  // Mesh request counter: only the request that finds it at zero queues a
+  // job, which keeps rebuilding until no request arrived during a build.
+  uint32_t addMeshRequest() {
+    return mesh_requests.fetch_add(1, std::memory_order_acq_rel);
+  }
+  uint32_t meshRequests() const {
+    return mesh_requests.load(std::memory_order_acquire);
+  }
+  bool finishMeshRequests(uint32_t seen) {
+    return mesh_requests.compare_exchange_strong(seen, 0,
+                                                 std::memory_order_acq_rel);
+  }
+
+  // Set once the chunk leaves render distance: queued generation and mesh
+  // jobs holding it return early and its pending upload is dropped.
+  void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+  bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
   ChunkMesh &getMesh() { return mesh; }
   glm::mat4 getModelMatrix() const;
   glm::ivec2 getPos() const { return pos; }
 
-  std::mutex data_mutex; // guards blocks[] during concurrent write/mesh-gen
+  // Guards block/light data: writers take it exclusively, readers shared.
+  SharedMutex data_mutex;
+  // Serializes mesh rebuilds of this chunk against each other and uploads.
+  std::mutex mesh_mutex;
 
 private:
+  // Nibble accessors over the packed light array, by linear index.
+  uint8_t skyNibble(int i) const { return light[i] >> 4; }
+  uint8_t blockNibble(int i) const { return light[i] & 0x0F; }
+  void setSkyNibble(int i, uint8_t v) {
+    light[i] = static_cast<uint8_t>((light[i] & 0x0F) | (v << 4));
+  }
+  void setBlockNibble(int i, uint8_t v) {
+    light[i] = static_cast<uint8_t>((light[i] & 0xF0) | (v & 0x0F));
+  }
+
   glm::ivec2 pos;
-  std::vector<BlockType> blocks;
-  std::vector<uint8_t>   skylight;
-  std::vector<uint8_t>   blocklight;
+  void updateHeightmap(int x, int y, int z, BlockType type);
+
+  std::array<ChunkSection, kSectionCount> sections;
+  std::array<int16_t, kChunkWidth * kChunkDepth> top_non_air;
+  std::array<int16_t, kChunkWidth * kChunkDepth> top_opaque;
+  std::vector<uint8_t>   light; // packed sky/block light, see packLight()
   int emitter_count = 0; // number of light-emitting blocks in this chunk
+  std::atomic<bool> cancelled{false};
+  std::atomic<ChunkState> state{ChunkState::Queued};
+  std::atomic<uint32_t> mesh_requests{0};
   ChunkMesh mesh;
 };
@@ -7,8 +7,7 @@
 #include <glad/glad.h>
 #include <vector>
 
-class Chunk;
-class World;
+class ChunkSnapshot;
 
 enum Face { Top, Bottom, Left, Right, Front, Back };
 
@@ -17,11 +16,9 @@ public:
   ChunkMesh();
   ~ChunkMesh();
 
-  static BlockType  getBlock(World*, const Chunk&, int, int, int);
-  static uint8_t    getSkyLight(World*, const Chunk&, int, int, int);
-  static uint8_t    getBlockLight(World*, const Chunk&, int, int, int);
-  void generateCPU(World* world, const Chunk& chunk, TextureManager& texture_manager); // CPU-only
+  void generateCPU(const ChunkSnapshot& snapshot, TextureManager& texture_manager); // CPU-only
   void upload();     // GL only (main thread)
+  void release();    // frees the GL objects; GL only (main thread)
   void renderOpaque();
   void renderTransparent();
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "block/block_type.hpp"
+#include "core/constants.hpp"
+#include <cstdint>
+#include <vector>
+
+// One 16x16x16 slice of a chunk's block data. A section holding a single
+// block type (all air above the terrain, all stone deep below it) is a
+// uniform sentinel that allocates nothing. Otherwise it is flat while the
+// generator fills it and gets compacted into a palette plus bit-packed
+// indices (1/2/4/8 bits per block) once generation is done. Local index
+// layout matches the chunk's: x + 16 * (z + 16 * y).
+class ChunkSection {
+public:
+  BlockType get(uint32_t i) const {
+    switch (mode) {
+    case Mode::Uniform: return uniform;
+    case Mode::Flat:    return flat[i];
+    default: {
+      const uint32_t bit = i * bits;
+      return palette[(words[bit >> 6] >> (bit & 63)) & mask()];
+    }
+    }
+  }
+
+  void set(uint32_t i, BlockType type);
+
+  // Collapses a single-type section to a uniform sentinel; otherwise packs it
+  // into palette form when `pack` is set. Later edits that break a uniform
+  // section re-expand it in the same form, and an edit that leaves it holding
+  // one type collapses it again.
+  void compact(bool pack);
+
+  // Writes all kSectionVolume blocks to `out` (mesher fast path).
+  void decode(BlockType *out) const;
+
+  bool isUniform() const { return mode == Mode::Uniform; }
+  BlockType uniformType() const { return uniform; } // valid if isUniform()
+  bool isEmpty() const { return isUniform() && uniform == BlockType::AIR; }
+  bool isPacked() const { return mode == Mode::Packed; }
+  size_t memoryUsage() const;
+
+private:
+  enum class Mode : uint8_t { Uniform, Flat, Packed };
+
+  uint64_t mask() const { return (uint64_t{1} << bits) - 1; }
+  int paletteIndex(BlockType type) const;
+  void write(uint32_t i, uint32_t p);
+  void repack(uint8_t new_bits);
+  // True if every block is `type`. Stops at the first other block, so mixed
+  // sections pay for a word or two.
+  bool holdsOnly(BlockType type, uint32_t p) const;
+  void collapse(BlockType type);
+
+  Mode mode = Mode::Uniform;
+  BlockType uniform = BlockType::AIR; // Uniform mode only
+  bool pack_edits = false;            // expand uniform sections straight to Packed
+  bool compacted = false;             // compact() has run; edits may collapse it
+  uint8_t bits = 0;                   // 1, 2, 4 or 8 while packed
+  std::vector<BlockType> flat;        // Flat mode only
+  std::vector<BlockType> palette;     // Packed mode only
+  std::vector<uint64_t> words;        // Packed mode only
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "block/block_type.hpp"
+#include "core/constants.hpp"
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Chunk;
+class World;
+
+// Padded copy of a chunk's blocks and packed light plus a one-voxel border
+// taken from its 8 neighbours (and one layer above/below the world), so the
+// mesher can read any sample it needs without locks or chunk-boundary
+// branches. Coordinates are chunk-local: x/z in -1..16, y in -1..256.
+// Unloaded neighbours read as air under full sky, like the world edge.
+class ChunkSnapshot {
+public:
+  static constexpr int kSizeX = kChunkWidth + 2;
+  static constexpr int kSizeY = kChunkHeight + 2;
+  static constexpr int kSizeZ = kChunkDepth + 2;
+  static constexpr int kVolume = kSizeX * kSizeY * kSizeZ;
+
+  ChunkSnapshot();
+
+  // Copies the chunk and its neighbours' border voxels, locking each chunk
+  // only while its own data is copied.
+  void capture(World *world, Chunk &chunk);
+
+  static int index(int x, int y, int z) {
+    return (x + 1) + kSizeX * ((z + 1) + kSizeZ * (y + 1));
+  }
+  BlockType block(int x, int y, int z) const { return blocks[index(x, y, z)]; }
+  uint8_t light(int x, int y, int z) const { return lights[index(x, y, z)]; }
+
+  glm::ivec2 getPos() const { return pos; }
+  int maxHeight() const { return max_height; }
+
+  // Per-section uniform block type of the chunk itself (side 0) and its
+  // -X, +X, -Z, +Z neighbours (sides 1-4); -1 when the section is mixed.
+  // Unloaded neighbours report uniform air.
+  int sectionUniform(int side, int s) const { return uniform[side][s]; }
+
+private:
+  glm::ivec2 pos{0};
+  int max_height = -1;
+  std::vector<BlockType> blocks;
+  std::vector<uint8_t> lights;
+  std::array<std::array<int16_t, kSectionCount>, 5> uniform{};
+};
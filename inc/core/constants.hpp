@@ -6,10 +6,19 @@ constexpr int kChunkHeight = 256;
 constexpr int kChunkDepth = 16;
 constexpr int kChunkWidth = 16;
 
+// Chunks are stored as a stack of 16-tall sections (see ChunkSection).
+constexpr int kSectionHeight = 16;
+constexpr int kSectionCount = kChunkHeight / kSectionHeight;
+constexpr int kSectionVolume = kChunkWidth * kChunkDepth * kSectionHeight;
+
 constexpr int kMaxAllowedChunks = 12000;
 constexpr int kChunkPreloadRadius = 20;
 constexpr int kMaxChunksPerFrame = 16;
 constexpr int kMaxUploadsPerFrame = 4;
+// Chunks stay loaded this many rings past the load radius, so pacing across a
+// chunk border doesn't unload and regenerate the outer ring each time.
+constexpr int kChunkUnloadMargin = 2;
+constexpr int kMaxUnloadsPerFrame = 32;
 
 // Note: view distance and window resolution are runtime settings loaded from
 // voxel.properties (see Settings::render_distance / window_width/height).
@@ -18,13 +27,16 @@ constexpr int kSeaLevel = (kChunkHeight * 2) / 5;
 constexpr int kSnowLevel = 130;
 constexpr int kTreeLevel = 180;
 
-constexpr int kBiomeTreeBorder = 4;
 constexpr float kBiomeFreq = 0.04f;
 constexpr float kBiomeAmp = 35.0f;
 constexpr float kBiomeOctaves = 4.0f;
 constexpr float kBiomeLacunarity = 1.2f;
 constexpr float kBiomeGain = 0.5f;
 
+// Bump whenever a change alters generated terrain: cached chunks written by
+// other generator versions are discarded (see ChunkCache).
+constexpr int kGeneratorVersion = 1;
+
 // Player dimensions (AABB)
 constexpr float kPlayerHeight = 1.8f;
 constexpr float kPlayerWidth = 0.6f;           // AABB width and depth
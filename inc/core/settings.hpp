@@ -10,6 +10,11 @@ struct Settings {
   uint32_t   world_seed;
   glm::vec2  noise_offset;  // added to all noise coordinates for seeding
   int        render_distance; // how far (in world units) chunks stay loaded
+  bool       palette_storage; // pack chunk blocks into per-section palettes
+  bool       binary_mesher;   // bitmask mesher instead of the scalar face sweeps
+  bool       chunk_cache;     // keep generated chunks on disk under saves/<world>/cache
+  int        chunk_cache_mb;  // size cap of that cache
+  int        unloaded_cache_mb; // memory for blocks of recently unloaded chunks
 
   // UI
   bool show_debug;
@@ -47,6 +52,8 @@ struct Settings {
   Settings()
       : world_name("world"),
         world_seed(0), noise_offset(0.0f, 0.0f), render_distance(320),
+        palette_storage(true), binary_mesher(true),
+        chunk_cache(true), chunk_cache_mb(256), unloaded_cache_mb(64),
         show_debug(false),
         window_width(1600), window_height(900),
         wireframe(false), vsync(false), fullscreen(true), show_cursor(false),
@@ -5,7 +5,6 @@
 #include "render/texture_manager.hpp"
 #include <memory>
 #include <vector>
-#include "robin_hood/robin_hood.h"
 
 // Per-frame culling stats for the debug panel. Written during render,
 // read on the same (main) thread by the ImGui code — no sync needed.
@@ -31,7 +30,7 @@ public:
                   const glm::vec3 &cameraPos, bool underwater, float timeOfDay);
 
   // Shadow map pass: render depth from the sun's POV
-  void shadowPass(const robin_hood::unordered_map<ChunkKey, std::shared_ptr<Chunk>, ChunkKeyHash> &chunks,
+  void shadowPass(const std::vector<Chunk *> &chunks,
                   const glm::vec3 &cameraPos, float timeOfDay,
                   int viewportWidth, int viewportHeight);
 
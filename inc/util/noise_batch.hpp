@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+// Batch counterparts of glm::perlin and fbm() (util/noise.hpp): the same
+// classic Perlin noise, evaluated for a whole list of points at once across
+// SIMD lanes. Points are passed as one array per coordinate, so a 16x16
+// column grid or a column of voxels is a single call.
+namespace NoiseBatch {
+
+void perlin2(const float *x, const float *y, float *out, size_t n);
+void perlin3(const float *x, const float *y, const float *z, float *out,
+             size_t n);
+// fbm() over perlin3.
+void fbm3(const float *x, const float *y, const float *z, float *out, size_t n,
+          int octaves, float lacunarity, float gain);
+
+// Compares the kernels against glm::perlin. Run once at startup: on a
+// mismatch it logs and every later call goes through glm::perlin instead.
+bool selfCheck();
+
+} // namespace NoiseBatch
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+// FIFO over a power-of-two ring buffer that only ever grows. Meant to be kept
+// and reused (per thread, or per owner), so once it has reached its working
+// size pushes and pops never touch the allocator — unlike std::queue, whose
+// deque allocates and frees blocks as it goes.
+template <class T> class RingQueue {
+public:
+  explicit RingQueue(size_t capacity = 1024)
+      : buffer(std::bit_ceil(capacity)), mask(buffer.size() - 1) {}
+
+  bool empty() const { return head == tail; }
+  size_t size() const { return tail - head; }
+
+  void push(const T &value) {
+    if (tail - head == buffer.size()) grow();
+    buffer[tail++ & mask] = value;
+  }
+  T pop() { return buffer[head++ & mask]; }
+  void clear() { head = tail = 0; }
+
+private:
+  void grow() {
+    std::vector<T> bigger(buffer.size() * 2);
+    const size_t bigger_mask = bigger.size() - 1;
+    for (size_t i = head; i != tail; ++i)
+      bigger[i & bigger_mask] = buffer[i & mask];
+    buffer.swap(bigger);
+    mask = bigger_mask;
+  }
+
+  std::vector<T> buffer;
+  size_t mask;
+  size_t head = 0, tail = 0; // monotonic; wrapped by `mask` on access
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Counter-based random stream for world generation. The n-th draw is a pure
+// hash of (key, n), and the key comes from the world seed and a chunk's
+// coordinates, so a chunk generates bit-identically on any thread, in any
+// order, on every run. No shared state: unlike rand(), nothing is locked.
+class Rng {
+public:
+  Rng(uint64_t seed, int cx, int cz)
+      : key(mix(mix(seed) ^ (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32 |
+                             static_cast<uint32_t>(cz)))) {}
+
+  uint32_t next() { return static_cast<uint32_t>(mix(key + ++counter * kGamma) >> 32); }
+
+  // Uniform in [0, bound) — the drop-in for `rand() % bound`.
+  int nextInt(int bound) {
+    return static_cast<int>((static_cast<uint64_t>(next()) * bound) >> 32);
+  }
+
+private:
+  static constexpr uint64_t kGamma = 0x9E3779B97F4A7C15ull;
+
+  // SplitMix64 finalizer.
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t key;
+  uint64_t counter = 0;
+};
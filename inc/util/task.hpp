@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Move-only `void()` callable with small-buffer storage. Callables up to
+// kInlineSize bytes (every job lambda the world enqueues) live inside the
+// Task itself, so queuing a job does not touch the heap the way
+// std::function does; larger ones fall back to a heap allocation.
+class Task {
+public:
+  static constexpr size_t kInlineSize = 48;
+
+  Task() = default;
+
+  template <class F, class = std::enable_if_t<
+                         !std::is_same_v<std::decay_t<F>, Task>>>
+  Task(F &&f) {
+    using Fn = std::decay_t<F>;
+    if constexpr (fitsInline<Fn>()) {
+      ::new (storage) Fn(std::forward<F>(f));
+      ops = &kInlineOps<Fn>;
+    } else {
+      *reinterpret_cast<Fn **>(storage) = new Fn(std::forward<F>(f));
+      ops = &kHeapOps<Fn>;
+    }
+  }
+
+  Task(Task &&other) noexcept { moveFrom(other); }
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+  ~Task() { reset(); }
+
+  void operator()() { ops->call(storage); }
+  explicit operator bool() const { return ops != nullptr; }
+
+private:
+  struct Ops {
+    void (*call)(void *);
+    void (*move)(void *dst, void *src); // move-construct dst, destroy src
+    void (*destroy)(void *);
+  };
+
+  template <class Fn> static constexpr bool fitsInline() {
+    return sizeof(Fn) <= kInlineSize &&
+           alignof(Fn) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Fn>;
+  }
+
+  template <class Fn>
+  static constexpr Ops kInlineOps = {
+      [](void *p) { (*static_cast<Fn *>(p))(); },
+      [](void *dst, void *src) {
+        ::new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+        static_cast<Fn *>(src)->~Fn();
+      },
+      [](void *p) { static_cast<Fn *>(p)->~Fn(); },
+  };
+
+  template <class Fn>
+  static constexpr Ops kHeapOps = {
+      [](void *p) { (**static_cast<Fn **>(p))(); },
+      [](void *dst, void *src) {
+        *static_cast<Fn **>(dst) = *static_cast<Fn **>(src);
+      },
+      [](void *p) { delete *static_cast<Fn **>(p); },
+  };
+
+  void moveFrom(Task &other) {
+    ops = other.ops;
+    if (ops) ops->move(storage, other.storage);
+    other.ops = nullptr;
+  }
+
+  void reset() {
+    if (ops) ops->destroy(storage);
+    ops = nullptr;
+  }
+
+  alignas(std::max_align_t) unsigned char storage[kInlineSize];
+  const Ops *ops = nullptr;
+};
@@ -1,23 +1,28 @@
 #pragma once
 
+#include "util/task.hpp"
+#include <atomic>
 #include <condition_variable>
-#include <functional>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
+// Work-stealing pool with per-worker priority queues. Each worker takes the
+// most urgent job at the head of any queue, its own or another worker's, so
+// priority holds across the whole pool while one slow job never stalls the
+// rest of the queue behind a single lock.
 class ThreadPool {
 public:
+  // Lower runs first; equal priorities run in submission order.
+  static constexpr int kDefaultPriority = 0;
+
   ThreadPool(size_t numThreads = std::thread::hardware_concurrency());
   ~ThreadPool();
 
-  template <class F> void enqueue(F &&f) {
-    {
-      std::unique_lock<std::mutex> lock(queue_mutex);
-      jobs.push(std::function<void()>(std::forward<F>(f)));
-    }
-    condition.notify_one();
+  template <class F> void enqueue(F &&f, int priority = kDefaultPriority) {
+    push(Task(std::forward<F>(f)), priority);
   }
 
   // Stops the pool: lets in-flight jobs finish, drops queued ones, joins all
@@ -25,10 +30,37 @@ public:
   void shutdown();
 
 private:
+  struct Job {
+    int priority;
+    uint64_t seq;
+    Task task;
+
+    // Heap order: the most urgent job compares greatest.
+    bool operator<(const Job &o) const {
+      return priority != o.priority ? priority > o.priority : seq > o.seq;
+    }
+  };
+
+  // One worker's queue: a binary heap ordered by (priority, seq).
+  struct Queue {
+    std::mutex mutex;
+    std::vector<Job> heap;
+  };
+
+  void push(Task &&task, int priority);
+  bool popFrom(Queue &queue, Task &out);
+  bool tryPop(size_t self, Task &out);
+  void run(size_t self);
+
+  std::vector<std::unique_ptr<Queue>> queues;
   std::vector<std::thread> workers;
-  std::queue<std::function<void()>> jobs;
 
-  std::mutex queue_mutex;
-  std::condition_variable condition;
-  bool stop = false;
+  std::atomic<uint64_t> next_seq{0};
+  std::atomic<size_t> next_queue{0}; // round-robin target for outside pushes
+  std::atomic<size_t> pending{0};    // jobs sitting in any queue
+
+  // Idle workers sleep here until a push or shutdown.
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  std::atomic<bool> stop{false};
 };
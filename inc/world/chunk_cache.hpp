@@ -0,0 +1,50 @@
+#pragma once
+
+#include "biome/decoration.hpp"
+#include "chunk/chunk.hpp" // ChunkKey, ChunkKeyHash
+#include "robin_hood/robin_hood.h"
+#include "util/lock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+// On-disk cache of generated chunks, one file per chunk in `dir` (normally
+// saves/<world>/cache), so revisited terrain is read back instead of being
+// regenerated. An entry holds the chunk as Chunk::generate() left it (no
+// player edits, no neighbours' trees) plus the decoration blocks it spilled
+// into its neighbours. Files whose header doesn't match the current seed and
+// kGeneratorVersion are treated as misses. Past `max_bytes` the least
+// recently used files are deleted. Thread-safe.
+class ChunkCache {
+public:
+  ChunkCache(std::string dir, size_t max_bytes);
+
+  // Fills a fresh chunk (Queued -> Decorated) and `overflow` from the cache.
+  // Returns false on a miss, leaving both untouched.
+  bool load(const ChunkKey &key, Chunk &chunk,
+            std::vector<DecorationWrite> &overflow);
+  // Writes a freshly generated chunk and its overflow.
+  void store(const ChunkKey &key, const Chunk &chunk,
+             const std::vector<DecorationWrite> &overflow);
+
+private:
+  std::string pathOf(const ChunkKey &key) const;
+  // LRU bookkeeping; the caller holds `mutex`.
+  void touch(const ChunkKey &key, size_t bytes);
+  void forget(const ChunkKey &key);
+
+  std::string dir;
+  size_t max_bytes;
+
+  std::mutex mutex;
+  std::list<ChunkKey> lru; // most recently used first
+  struct Entry {
+    std::list<ChunkKey>::iterator pos;
+    size_t bytes;
+  };
+  robin_hood::unordered_map<ChunkKey, Entry, ChunkKeyHash> entries;
+  size_t total_bytes = 0;
+  std::atomic<uint32_t> temp_counter{0}; // unique names for in-flight writes
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "chunk/chunk.hpp"
+#include "robin_hood/robin_hood.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Concurrent chunk map with lock-free reads. Keys are spread over shards,
+// each an immutable table behind an atomic pointer. Writers copy the shard's
+// table, modify the copy and publish it (copy-on-write; a shard holds a few
+// dozen chunks), and the old table is retired until no reader can still see
+// it. Readers never lock and never touch a refcount:
+//
+//   ChunkMap::ReadGuard guard(map);
+//   if (Chunk *c = map.find({x, z})) ...  // valid until `guard` ends
+//
+// Retired tables keep their shared_ptrs alive, so a chunk erased while a
+// reader borrows it stays valid until collect(), which the world calls once
+// per frame on the main thread. Jobs holding their own shared_ptr may still
+// outlive that and destroy the chunk on a worker, so the world frees a
+// chunk's GL objects itself when it erases it (Chunk::releaseGPU()).
+class ChunkMap {
+public:
+  using Table =
+      robin_hood::unordered_flat_map<ChunkKey, std::shared_ptr<Chunk>, ChunkKeyHash>;
+
+  // Pins the tables the current thread can see. Nests freely.
+  class ReadGuard {
+  public:
+    explicit ReadGuard(const ChunkMap &map);
+    ~ReadGuard();
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+  private:
+    std::atomic<uint64_t> *slot = nullptr; // null when nested
+  };
+
+  ChunkMap();
+  ~ChunkMap();
+  ChunkMap(const ChunkMap &) = delete;
+  ChunkMap &operator=(const ChunkMap &) = delete;
+
+  // Borrowed lookup; requires a live ReadGuard on this thread.
+  Chunk *find(const ChunkKey &key) const {
+    const Table &table = *shards[shardOf(key)].table.load();
+    auto it = table.find(key);
+    return it == table.end() ? nullptr : it->second.get();
+  }
+
+  // Owning lookup; no guard needed.
+  std::shared_ptr<Chunk> get(const ChunkKey &key) const;
+  bool contains(const ChunkKey &key) const;
+  size_t size() const { return count.load(std::memory_order_relaxed); }
+
+  // Calls f(key, chunk) for every chunk; requires a live ReadGuard.
+  template <class F> void forEach(F &&f) const {
+    for (const Shard &shard : shards)
+      for (const auto &[key, chunk] : *shard.table.load())
+        f(key, *chunk);
+  }
+
+  // False (and no change) if the key is already present.
+  bool insert(const ChunkKey &key, std::shared_ptr<Chunk> chunk);
+  // Returns the removed chunk, or null if there was none.
+  std::shared_ptr<Chunk> erase(const ChunkKey &key);
+
+  // Frees retired tables no reader can still see. Main thread only.
+  void collect();
+
+private:
+  static constexpr size_t kShardCount = 64;
+  static constexpr size_t kMaxReaders = 128; // threads reading at once
+  static constexpr uint64_t kIdle = UINT64_MAX;
+
+  struct Shard {
+    std::mutex write_mutex;
+    std::atomic<const Table *> table;
+  };
+
+  struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch{kIdle}; // epoch seen on entry, or kIdle
+  };
+
+  static size_t shardOf(const ChunkKey &key) {
+    const uint32_t h = static_cast<uint32_t>(key.x) * 73856093u ^
+                       static_cast<uint32_t>(key.z) * 19349663u;
+    return (h ^ (h >> 16)) & (kShardCount - 1);
+  }
+
+  // Index of the calling thread's reader slot, claimed on first use.
+  static size_t threadSlot();
+  void retire(const Table *table);
+
+  std::array<Shard, kShardCount> shards;
+  std::atomic<size_t> count{0};
+
+  // Epoch-based reclamation: a table retired at epoch e may be freed once
+  // every active reader entered after e.
+  mutable std::array<ReaderSlot, kMaxReaders> readers;
+  std::atomic<uint64_t> epoch{1};
+  std::mutex retired_mutex;
+  std::vector<std::pair<uint64_t, const Table *>> retired;
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "block/block_data.hpp"
+#include "block/block_type.hpp"
+#include "chunk/chunk.hpp"
+#include "util/ring_queue.hpp"
+#include "world/chunk_map.hpp"
+#include <array>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Incremental sky/block light propagation across chunk borders. A change only
+// re-floods the voxels whose light actually depends on it, using the usual
+// two-queue BFS: a decrease pass darkens everything the old light reached and
+// collects the brighter voxels around it, then an increase pass floods from
+// those and from any light sources that were darkened.
+//
+// Light reaches at most 15 blocks, so every operation works on the 3x3 chunks
+// around one chunk. It runs against copies: each chunk's heightmaps up front,
+// and a 16-tall section's blocks and light the first time the flood reaches
+// it, each under a brief read lock. The flood runs with no chunk locked, so
+// neither readers nor block writers are held up by it, and its cost follows
+// the sections the light change touches rather than the region. Changed
+// sections are committed under brief write locks. Unloaded chunks act as
+// opaque.
+//
+// Only the engine writes light into loaded chunks, so operations must run one
+// at a time and in submission order: the World submits them all to a
+// one-thread pool at a single priority, which the pool runs first-in
+// first-out.
+class LightEngine {
+public:
+  explicit LightEngine(ChunkMap &chunks);
+
+  // A block at world position `pos` that was just changed from `old_type`.
+  struct BlockChange {
+    glm::ivec3 pos;
+    BlockType old_type;
+  };
+
+  // Relights around world position `pos`, whose block was just changed from
+  // `old_type`. `dirty` receives the chunks whose mesh is now stale.
+  void blockChanged(const glm::ivec3 &pos, BlockType old_type,
+                    std::vector<ChunkKey> &dirty);
+  // blockChanged() for `n` changes in order. Consecutive changes in the same
+  // chunk share one region, copied and committed once.
+  void blocksChanged(const BlockChange *changes, size_t n,
+                     std::vector<ChunkKey> &dirty);
+
+  // Lets sky light (and block light, if `block_light`) flow across the
+  // borders of the freshly loaded chunk (cx, cz) in both directions.
+  // Generation lights each chunk on its own.
+  void stitchLight(int cx, int cz, bool block_light,
+                   std::vector<ChunkKey> &dirty);
+
+private:
+  enum class Channel { Sky, Block };
+
+  // Region-local voxel, packed as x | z << 6 | y << 12 with x/z in
+  // [0, kSpan * 16) from the region's min corner. Neighbours are one step
+  // away; the decrease queue stores the old level above the voxel bits.
+  using Voxel = uint32_t;
+  static constexpr uint32_t kStepX = 1, kStepZ = 1 << 6, kStepY = 1 << 12;
+  static constexpr int kLevelShift = 20;
+
+  static Voxel voxel(int x, int y, int z) {
+    return static_cast<Voxel>(x) | static_cast<Voxel>(z) << 6 |
+           static_cast<Voxel>(y) << 12;
+  }
+  static int xOf(Voxel v) { return v & 63; }
+  static int zOf(Voxel v) { return (v >> 6) & 63; }
+  static int yOf(Voxel v) { return v >> 12; }
+  // Linear index of `v` within its own chunk.
+  static uint32_t chunkIndex(Voxel v) {
+    return (v & (kChunkWidth - 1)) +
+           kChunkWidth * (((v >> 6) & (kChunkDepth - 1)) + kChunkDepth * yOf(v));
+  }
+
+  // One chunk of the region: the chunk, and the engine's copy of its data.
+  // `blocks` and `light` are valid only for the sections marked `copied`.
+  struct Slot {
+    Chunk *chunk = nullptr;
+    int max_height = -1;
+    std::array<bool, kSectionCount> copied{};
+    std::array<bool, kSectionCount> changed{}; // light written, to be committed
+    std::vector<BlockType> blocks;
+    std::vector<uint8_t> light;
+    std::array<int16_t, kChunkWidth * kChunkDepth> top_non_air;
+    std::array<int16_t, kChunkWidth * kChunkDepth> top_opaque;
+
+    int topNonAir(int x, int z) const { return top_non_air[x + kChunkWidth * z]; }
+    int topOpaque(int x, int z) const { return top_opaque[x + kChunkWidth * z]; }
+  };
+
+  static constexpr int kSpan = 3; // chunks per side of a region
+  static constexpr int kRegionWidth = kSpan * kChunkWidth;
+  static constexpr int kRegionDepth = kSpan * kChunkDepth;
+
+  // Borrows the 3x3 chunks around (cx, cz) and copies their heightmaps.
+  // Requires a live ChunkMap::ReadGuard. commitRegion() writes back the light
+  // sections that changed.
+  void beginRegion(int cx, int cz);
+  void commitRegion(std::vector<ChunkKey> &dirty);
+
+  Slot &slotOf(Voxel v) {
+    return grid[xOf(v) / kChunkWidth][zOf(v) / kChunkDepth];
+  }
+  const Slot &slotOf(Voxel v) const {
+    return grid[xOf(v) / kChunkWidth][zOf(v) / kChunkDepth];
+  }
+  // Slot of `v` with the section holding `v` copied in.
+  Slot &loaded(Voxel v) {
+    Slot &slot = slotOf(v);
+    const int s = yOf(v) / kSectionHeight;
+    if (!slot.copied[s]) copySection(slot, s);
+    return slot;
+  }
+  void copySection(Slot &slot, int s);
+  BlockType blockAt(Voxel v) { return loaded(v).blocks[chunkIndex(v)]; }
+  uint8_t get(Channel ch, Voxel v);
+  void set(Channel ch, Voxel v, uint8_t level);
+  // Light `v` produces by itself: emission, or direct sky down its column.
+  uint8_t source(Channel ch, Voxel v);
+  uint8_t opacity(Voxel v) { return skyLightOpacity(blockAt(v)); }
+  // Direct sky for column `c` at y <= y_top into `out`, as if the block at
+  // `override_y` were `override_type`. Reads the chunk itself: one column
+  // isn't worth copying its sections for.
+  void directColumn(Voxel c, int y_top, int override_y,
+                    BlockType override_type, uint8_t *out) const;
+
+  // Calls f(n) for each neighbour of `v` that lies in a loaded chunk.
+  template <class F> void forNeighbours(Voxel v, F &&f) const {
+    auto visit = [&](Voxel n) {
+      if (slotOf(n).chunk) f(n);
+    };
+    const int x = xOf(v), y = yOf(v), z = zOf(v);
+    if (x > 0)                 visit(v - kStepX);
+    if (x < kRegionWidth - 1)  visit(v + kStepX);
+    if (y > 0)                 visit(v - kStepY);
+    if (y < kChunkHeight - 1)  visit(v + kStepY);
+    if (z > 0)                 visit(v - kStepZ);
+    if (z < kRegionDepth - 1)  visit(v + kStepZ);
+  }
+
+  // Zeroes `v` and queues it for the decrease pass; light sources among the
+  // darkened voxels are relit afterwards.
+  void darken(Channel ch, Voxel v, uint8_t level);
+  void removeLight(Channel ch);
+  void addLight(Channel ch);
+  // Marks the chunk holding `v`, plus any neighbour whose mesh samples it.
+  void markDirty(Voxel v);
+  // One change of blocksChanged(), inside the open region.
+  void relight(const BlockChange &change);
+
+  ChunkMap &chunks;
+
+  int region_x = 0, region_z = 0; // chunk coords of the region's min corner
+  Slot grid[kSpan][kSpan];
+  // Chunks to remesh, over the region plus a one-chunk border.
+  std::array<std::array<bool, kSpan + 2>, kSpan + 2> dirty_marks{};
+
+  RingQueue<uint32_t> remove_queue; // voxel | old level << kLevelShift
+  RingQueue<Voxel> add_queue;
+  std::vector<Voxel> relit_sources; // sources darkened by a decrease pass
+};
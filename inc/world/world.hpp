@@ -1,5 +1,6 @@
 #pragma once
 
+#include "biome/biome_map.hpp"
 #include "block/block_type.hpp"
 #include "chunk/chunk.hpp"
 #include "player/player.hpp"
@@ -7,11 +8,16 @@
 #include "robin_hood/robin_hood.h"
 #include "util/lock.hpp"
 #include "util/thread_pool.hpp"
+#include "world/chunk_cache.hpp"
+#include "world/chunk_map.hpp"
+#include "world/light_engine.hpp"
 #include "world/world_save.hpp"
 #include <atomic>
 #include <glm/glm.hpp>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <queue>
 
 // Result of a DDA raycast into the voxel world
 struct RaycastResult {
@@ -34,6 +40,8 @@ public:
   void addChunk(int x, int z);
   std::shared_ptr<Chunk> getChunk(int x, int z);
   std::shared_ptr<const Chunk> getChunk(int x, int z) const;
+  // Lock-free chunk map, for borrowed lookups under a ChunkMap::ReadGuard.
+  const ChunkMap &getChunkMap() const { return chunks; }
   std::unique_ptr<Player> &getPlayer() { return player; }
   size_t getChunkCount() const;
 
@@ -41,6 +49,8 @@ public:
   // Installed before init(); consulted while generating chunks / placing spawn.
   void setLoadedEdits(WorldEdits e);
   void setLoadedPlayer(const WorldSave::PlayerData &p);
+  // Reads and writes generated chunks through an on-disk cache in `dir`.
+  void enableChunkCache(const std::string &dir, size_t max_bytes);
   // Thread-safe copy of all player edits, for writing to disk.
   WorldEdits snapshotEdits() const;
 
@@ -59,33 +69,84 @@ public:
 
 private:
   void rebuildChunk(int cx, int cz);
-  // Cross-chunk block-light: recompute a 5x5 chunk box around (ccx,ccz) into a
-  // temp buffer and persist the inner 3x3, so torch light bleeds across borders.
-  void relightBlockRegion(int ccx, int ccz);
+  // Queues a Lit chunk's first mesh once all 8 neighbours are Lit too.
+  void queueFirstMesh(const std::shared_ptr<Chunk> &chunk, int priority);
+  // Queues a mesh job unless one is pending; requests made while a job runs
+  // make it rebuild once more.
+  void requestMesh(const std::shared_ptr<Chunk> &chunk, int priority);
   // True if any loaded chunk within `radius` chunks of (ccx,ccz) has an emitter.
   bool anyEmitterInRegion(int ccx, int ccz, int radius) const;
   void preloadChunks();
   bool isChunkInFrustum(const glm::vec4 planes[6], const glm::vec3 &min, const glm::vec3 &max);
+  // Pool priority for generating/meshing chunk (cx,cz): nearest first, with
+  // chunks outside the last rendered frustum pushed back. Main thread only.
+  int chunkPriority(int cx, int cz);
   std::vector<glm::ivec2> generateSpiralOrder(int radius);
   std::vector<glm::ivec2> spiral_offsets;
   void updateLoadedChunks();
+  // Unloads up to kMaxUnloadsPerFrame chunks from `unload_backlog` that are
+  // still out of range. Main thread, once per frame.
+  void unloadDistantChunks();
+  // Past the unload radius (load radius + kChunkUnloadMargin) of the player.
+  bool beyondUnloadRadius(const ChunkKey &key) const;
   void unloadChunk(int x, int z);
+  // True if (x,z) is loaded or still queued for generation.
+  bool isChunkTracked(int x, int z) const;
+  // Keeps the blocks of a chunk leaving range in the recently-unloaded
+  // cache, evicting the oldest past its budget.
+  void parkChunk(const ChunkKey &key, Chunk &chunk);
+  // `key`'s blocks in that cache, left in place; null if not there.
+  std::shared_ptr<const ChunkBlocks> findParked(const ChunkKey &key);
+  // Drops `key`'s entry from that cache if it still holds `blocks`.
+  void unparkChunk(const ChunkKey &key, const ChunkBlocks *blocks);
+
+  // ─── Cross-chunk decorations ─────────────────────────────────────────────
+  // Stashes decoration blocks a chunk spilled into its neighbours, and places
+  // them right away in neighbours that are already loaded.
+  void shareDecorations(const std::vector<DecorationWrite> &writes);
+  // Places the stashed decorations for `key` into its still-unpublished
+  // chunk. Returns the stash version it saw.
+  uint32_t takeDecorations(const ChunkKey &key, Chunk &chunk);
+  // Places `blocks` into the loaded chunk `key` (never over player edits),
+  // then relights and remeshes around what changed.
+  void placeDecorations(const ChunkKey &key, const ChunkEdits &blocks);
+  // Drops the stashes no loaded, pending or parked chunk can still need.
+  // Main thread only.
+  void pruneDecorations();
 
   ThreadPool gen_pool{6};
   ThreadPool mesh_pool{6};
-  mutable SharedMutex chunks_mutex;
+  // Runs LightEngine jobs. One worker, and every job at the default priority:
+  // the engine relights one region at a time, in submission order.
+  ThreadPool light_pool{1};
+  // Guards `pending` and `upload_queue`, and orders publishing a generated
+  // chunk against unloading it. Lookups in `chunks` never take it.
+  mutable std::mutex queue_mutex;
 
   std::unique_ptr<Renderer> renderer;
   std::unique_ptr<Player> player;
 
+  ChunkMap chunks;
+  // Biome cells around the loaded area, shared by the generation workers.
+  BiomeMap biome_map;
+  // Relights block edits and chunk borders; driven only by light_pool.
+  LightEngine light_engine{chunks};
+  // Chunks queued for generation but not yet in `chunks`, so they aren't
+  // queued twice and can be cancelled if they fall out of range first.
   robin_hood::unordered_map<ChunkKey, std::shared_ptr<Chunk>, ChunkKeyHash>
-      chunks;
-  std::queue<std::shared_ptr<Chunk>> mesh_queue;
+      pending;
   std::queue<std::shared_ptr<Chunk>> upload_queue;
+  // Loaded chunks found out of range by updateLoadedChunks(), left for
+  // unloadDistantChunks() to drop a few at a time. Main thread only.
+  std::vector<ChunkKey> unload_backlog;
 
   int last_chunk_x = 0;
   int last_chunk_z = 0;
 
+  // Frustum of the last rendered frame, for chunkPriority().
+  glm::vec4 frustum_planes[6];
+  bool has_frustum = false;
+
   float cloud_time = 0.0f; // accumulated time for cloud drift
 
   // Player block edits, recorded in setBlockAt() and replayed onto freshly
@@ -93,12 +154,40 @@ private:
   mutable std::mutex edits_mutex;
   WorldEdits edits;
 
+  // Decoration blocks by the chunk they land in, merged with
+  // decorationReplaces() so arrival order doesn't matter. Kept while the
+  // chunk or any neighbour is loaded, pending or parked (pruneDecorations()).
+  struct PendingDecorations {
+    ChunkEdits blocks;
+    uint32_t version = 0; // bumped by every merge
+  };
+  std::mutex decorations_mutex;
+  robin_hood::unordered_map<ChunkKey, PendingDecorations, ChunkKeyHash>
+      decorations;
+
+  // Recently unloaded chunks' blocks, most recent first, bounded by
+  // Settings::unloaded_cache_mb. An entry stays until its chunk is back in
+  // the map, so a reload cancelled on the way loses nothing. Guarded by
+  // `parked_mutex`, which nests inside `queue_mutex`.
+  struct ParkedChunk {
+    ChunkKey key;
+    std::shared_ptr<const ChunkBlocks> blocks;
+    size_t bytes;
+  };
+  std::mutex parked_mutex;
+  std::list<ParkedChunk> parked;
+  robin_hood::unordered_map<ChunkKey, std::list<ParkedChunk>::iterator,
+                            ChunkKeyHash>
+      parked_index;
+  size_t parked_bytes = 0;
+
+  // Generated chunks on disk; null when disabled.
+  std::unique_ptr<ChunkCache> chunk_cache;
+
   bool has_loaded_player = false;
   WorldSave::PlayerData loaded_player;
 
-  // Cross-chunk relight requests queued from generation, drained on the main
-  // thread in update(). Gated by emitters_exist so torch-free worlds pay nothing.
+  // Set once any chunk has an emitter; gates the block-light half of border
+  // stitches so torch-free worlds pay nothing for it.
   std::atomic<bool> emitters_exist{false};
-  std::mutex relight_mutex;
-  std::vector<glm::ivec2> relight_requests;
 };
@@ -1,108 +1,185 @@
 #include "biome/biome.hpp"
+#include "biome/biome_manager.hpp"
 #include "block/block_type.hpp"
 #include "core/constants.hpp"
 #include "core/settings.hpp"
 #include "util/noise.hpp"
+#include "util/noise_batch.hpp"
+#include <algorithm>
 #include <glm/fwd.hpp>
+#include <vector>
 
-void Biome::generateTerrain(Chunk &chunk) {
-  glm::vec2 pos = chunk.getPos();
+void Biome::generateTerrain(Chunk &chunk, const ColumnData &columns,
+                            Rng &rng) {
   for (int x = 0; x < kChunkWidth; x++) {
     for (int z = 0; z < kChunkDepth; z++) {
-      const int world_x = pos[0] * kChunkWidth + x;
-      const int world_z = pos[1] * kChunkDepth + z;
-      int h = getHeight({world_x, world_z});
+      int h = columns.at(x, z).height;
       if (h >= kChunkHeight) {
         h = kChunkHeight - 1;
       }
-      for (int y = 0; y < kChunkHeight; ++y) {
-        if (y < h) {
-          if (y == h - 1) {
-            BlockType top = generateTopBlock(y);
-            if (y >= kSnowLevel) {
-              if (top == BlockType::STONE) {
-                top = BlockType::SNOW_STONE;
-              } else if (top == BlockType::DIRT || top == BlockType::GRASS) {
-                top = BlockType::SNOW_DIRT;
-              }
-            }
-            if (y <= kSeaLevel) {
-              if (y > kSeaLevel - 3) {
-                top = BlockType::SAND;
-              } else {
-                top = BlockType::SANDSTONE;
-              }
-            }
-            chunk.at(x, y, z) = top;
-          } else {
-            chunk.at(x, y, z) = generateInternalBlock(x, y, z);
-          }
+      // Everything from h up stays air — fresh sections are all-air sentinels.
+      for (int y = 0; y < h - 1; ++y)
+        chunk.setBlock(x, y, z, generateInternalBlock(y, rng));
+      if (h < 1) continue;
+
+      const int y = h - 1;
+      const Biome &biome = BiomeManager::getBiome(columns.at(x, z).biome);
+      BlockType top = biome.generateTopBlock(y, rng);
+      if (y >= kSnowLevel) {
+        if (top == BlockType::STONE) {
+          top = BlockType::SNOW_STONE;
+        } else if (top == BlockType::DIRT || top == BlockType::GRASS) {
+          top = BlockType::SNOW_DIRT;
+        }
+      }
+      if (y <= kSeaLevel) {
+        if (y > kSeaLevel - 3) {
+          top = BlockType::SAND;
         } else {
-          chunk.at(x, y, z) = BlockType::AIR;
+          top = BlockType::SANDSTONE;
         }
       }
+      chunk.setBlock(x, y, z, top);
     }
   }
 }
 
-void Biome::fillWater(Chunk &chunk) {
-  glm::vec2 pos = chunk.getPos();
+void Biome::fillWater(Chunk &chunk) const {
   for (int x = 0; x < kChunkWidth; ++x) {
     for (int z = 0; z < kChunkDepth; ++z) {
-      const int world_x = pos.x * kChunkWidth + x;
-      const int world_z = pos.y * kChunkDepth + z;
-      int h = getHeight({world_x, world_z});
+      // Terrain is solid up to its surface, so the heightmap gives the
+      // column height without re-sampling the noise.
+      int h = chunk.topNonAir(x, z) + 1;
 
       for (int y = h; y <= kSeaLevel && y < kChunkHeight; ++y) {
         if (chunk.at(x, y, z) == BlockType::AIR) {
-          chunk.at(x, y, z) = BlockType::WATER;
+          chunk.setBlock(x, y, z, BlockType::WATER);
         }
       }
     }
   }
 }
 
-void Biome::generateMinerals(Chunk &chunk) {
-  glm::vec2 pos = chunk.getPos();
+namespace {
+
+constexpr int kOreMinY = 6, kOreMaxY = kChunkHeight - 5; // [min, max)
+constexpr float kOreFreq = 0.05f;
+
+// Ore for a stone voxel with mineral noise `n`; STONE if none.
+BlockType oreFor(float n, Rng &rng) {
+  // RARE ORES
+  if (n >= 0.8f) {
+    int gem_chance = rng.nextInt(10) + 1;
+    if (gem_chance == 1)
+      return BlockType::DIAMOND_ORE;
+    else if (gem_chance <= 4)
+      return BlockType::EMERALD_ORE;
+    else if (gem_chance <= 6)
+      return BlockType::RUBY_ORE;
+    else
+      return BlockType::GOLD_ORE;
+  } else if (n >= 0.6f) {
+    return BlockType::IRON_ORE;
+  } else if (n >= 0.5f) {
+    return BlockType::COPPER_ORE;
+  } else if (n >= 0.4f) {
+    return BlockType::COAL_ORE;
+  }
+  return BlockType::STONE;
+}
+
+} // namespace
+
+void Biome::generateMinerals(Chunk &chunk, Rng &rng) const {
+  const glm::vec2 pos = chunk.getPos();
+  const int top = std::min(chunk.maxHeight(), kOreMaxY - 1);
+  if (top < kOreMinY) return;
+  const float base_x = pos.x * kChunkWidth + g_settings.noise_offset.x;
+  const float base_z = pos.y * kChunkDepth + g_settings.noise_offset.y;
 
+  // Noise for the stone voxels of one column, then their ores.
+  float nx[kOreMaxY], ny[kOreMaxY], nz[kOreMaxY], noise[kOreMaxY];
+  int stone_y[kOreMaxY];
+  auto placeOres = [&](int x, int z, int count) {
+    for (int i = 0; i < count; ++i) {
+      const BlockType ore = oreFor(noise[i], rng);
+      if (ore != BlockType::STONE) chunk.setBlock(x, stone_y[i], z, ore);
+    }
+  };
+  auto gatherStone = [&](int x, int z) {
+    int count = 0;
+    for (int y = kOreMinY; y <= top; ++y)
+      if (chunk.at(x, y, z) == BlockType::STONE) stone_y[count++] = y;
+    return count;
+  };
+
+  const int s = ore_noise_spacing;
+  if (s <= 1) {
+    // Exact: one noise sample per stone voxel, a batch per column.
+    for (int x = 0; x < kChunkWidth; ++x) {
+      for (int z = 0; z < kChunkDepth; ++z) {
+        const int count = gatherStone(x, z);
+        for (int i = 0; i < count; ++i) {
+          nx[i] = (base_x + x) * kOreFreq;
+          ny[i] = stone_y[i] * kOreFreq;
+          nz[i] = (base_z + z) * kOreFreq;
+        }
+        NoiseBatch::perlin3(nx, ny, nz, noise, count);
+        placeOres(x, z, count);
+      }
+    }
+    return;
+  }
+
+  // Coarse: sample a lattice every `s` blocks (one batch for the chunk) and
+  // interpolate trilinearly in between.
+  const int lx = (kChunkWidth + s - 1) / s + 1;
+  const int lz = (kChunkDepth + s - 1) / s + 1;
+  const int ly = (top - kOreMinY) / s + 2;
+  const size_t n = static_cast<size_t>(lx) * lz * ly;
+  thread_local std::vector<float> px, py, pz, lattice;
+  px.resize(n);
+  py.resize(n);
+  pz.resize(n);
+  lattice.resize(n);
+  auto at = [&](int i, int j, int k) { return (k * lz + j) * lx + i; };
+  for (int k = 0; k < ly; ++k)
+    for (int j = 0; j < lz; ++j)
+      for (int i = 0; i < lx; ++i) {
+        px[at(i, j, k)] = (base_x + i * s) * kOreFreq;
+        py[at(i, j, k)] = (kOreMinY + k * s) * kOreFreq;
+        pz[at(i, j, k)] = (base_z + j * s) * kOreFreq;
+      }
+  NoiseBatch::perlin3(px.data(), py.data(), pz.data(), lattice.data(), n);
+
+  float column[kOreMaxY];
   for (int x = 0; x < kChunkWidth; ++x) {
+    const int i = x / s;
+    const float tx = float(x % s) / s;
     for (int z = 0; z < kChunkDepth; ++z) {
-      for (int y = 6; y < kChunkHeight - 5; ++y) {
-        BlockType &block = chunk.at(x, y, z);
-
-        if (block == BlockType::STONE) {
-          float n = glm::perlin(glm::vec3(
-            (pos.x * kChunkWidth + x + g_settings.noise_offset.x) * 0.05f,
-            y * 0.05f,
-            (pos.y * kChunkDepth + z + g_settings.noise_offset.y) * 0.05f
-          ));
-
-          // RARE ORES
-          if (n >= 0.8f) {
-            int gem_chance = rand() % 10 + 1;
-            if (gem_chance == 1)
-              block = BlockType::DIAMOND_ORE;
-            else if (gem_chance <= 4)
-              block = BlockType::EMERALD_ORE;
-            else if (gem_chance <= 6)
-              block = BlockType::RUBY_ORE;
-            else
-              block = BlockType::GOLD_ORE;
-          } else if (n >= 0.6f) {
-            block = BlockType::IRON_ORE;
-          } else if (n >= 0.5f) {
-            block = BlockType::COPPER_ORE;
-          } else if (n >= 0.4f) {
-            block = BlockType::COAL_ORE;
-          }
-        }
+      const int count = gatherStone(x, z);
+      if (count == 0) continue;
+      const int j = z / s;
+      const float tz = float(z % s) / s;
+      // Bilinear down to this column at every lattice layer...
+      for (int k = 0; k < ly; ++k) {
+        const float a = glm::mix(lattice[at(i, j, k)], lattice[at(i + 1, j, k)], tx);
+        const float b = glm::mix(lattice[at(i, j + 1, k)], lattice[at(i + 1, j + 1, k)], tx);
+        column[k] = glm::mix(a, b, tz);
       }
+      // ...then linear between layers.
+      for (int c = 0; c < count; ++c) {
+        const int k = (stone_y[c] - kOreMinY) / s;
+        const float ty = float((stone_y[c] - kOreMinY) % s) / s;
+        noise[c] = glm::mix(column[k], column[k + 1], ty);
+      }
+      placeOres(x, z, count);
     }
   }
 }
 
-BlockType Biome::generateInternalBlock(int, int y, int) {
-  int rando = rand() % 10 + 1;
+BlockType Biome::generateInternalBlock(int y, Rng &rng) {
+  int rando = rng.nextInt(10) + 1;
 
   // Always bedrock at the bottom few layers
   if (y <= 5) {
@@ -122,31 +199,27 @@ BlockType Biome::generateInternalBlock(int, int y, int) {
   return rando > 8 ? BlockType::COBBLESTONE : BlockType::DIRT;
 }
 
-int Biome::getHeight(glm::vec2 pos, float *biome_noise_out) {
+namespace {
+
+float toUnit(float n) { return glm::clamp(n * 0.5f + 0.5f, 0.0f, 1.0f); }
+
+// Turns getHeight()'s raw noise samples into a column height: continent and
+// ocean-floor perlin, the detail fbm and the [0, 1] biome noise.
+int shapeHeight(float continent, double detail, float biome_n, float ocean) {
   constexpr int HMIN = 2;
   constexpr int HMAX = kChunkHeight - 1;
   constexpr int SEA = kSeaLevel;
   const float sea_norm = float(SEA) / float(HMAX);
 
-  const glm::vec2 spos = pos + g_settings.noise_offset;
-
   // --- Continents (0=ocean, 1=land) ---
-  float c = glm::clamp(glm::perlin(spos * 0.0008f) * 0.5f + 0.5f, 0.0f, 1.0f);
+  float c = toUnit(continent);
 
   // --- Local detail ---
-  glm::vec3 p((spos.x + 0.1f) * kBiomeFreq, (spos.y + 0.1f) * kBiomeFreq, 0.0f);
-  double n = fbm(p, kBiomeOctaves, kBiomeLacunarity, kBiomeGain);
-  float e = glm::clamp(float(n * 0.5 + 0.5), 0.0f, 1.0f);
-
-  // --- Biome noise (plains vs mountains) ---
-  glm::vec2 bpos = spos * 0.0045f;
-  float biome_n = glm::clamp(glm::perlin(bpos) * 0.5f + 0.5f, 0.0f, 1.0f);
-  if (biome_noise_out)
-    *biome_noise_out = biome_n;
+  float e = glm::clamp(float(detail * 0.5 + 0.5), 0.0f, 1.0f);
 
   // --- Ocean floor ---
   float ocean_floor = glm::mix(0.05f, sea_norm - 0.15f, e);
-  ocean_floor += glm::perlin(spos * 0.003f) * 0.015f;
+  ocean_floor += ocean * 0.015f;
   ocean_floor = glm::clamp(ocean_floor, 0.0f, sea_norm - 0.02f);
 
   // --- Land elevation ---
@@ -163,3 +236,101 @@ int Biome::getHeight(glm::vec2 pos, float *biome_noise_out) {
   int h = int(std::round(elev_norm * HMAX));
   return glm::clamp(h, HMIN, HMAX);
 }
+
+} // namespace
+
+int Biome::getHeight(glm::vec2 pos, float *biome_noise_out) {
+  const glm::vec2 spos = pos + g_settings.noise_offset;
+
+  glm::vec3 p((spos.x + 0.1f) * kBiomeFreq, (spos.y + 0.1f) * kBiomeFreq, 0.0f);
+  double n = fbm(p, kBiomeOctaves, kBiomeLacunarity, kBiomeGain);
+
+  // --- Biome noise (plains vs mountains) ---
+  float biome_n = toUnit(glm::perlin(spos * 0.0045f));
+  if (biome_noise_out)
+    *biome_noise_out = biome_n;
+
+  return shapeHeight(glm::perlin(spos * 0.0008f), n, biome_n,
+                     glm::perlin(spos * 0.003f));
+}
+
+// The +1000/+2000 offsets and distinct frequencies keep these uncorrelated
+// with the continent/biome noise used in getHeight().
+float Biome::getTemperature(glm::vec2 pos) {
+  const glm::vec2 spos = pos + g_settings.noise_offset;
+  return toUnit(glm::perlin((spos + 1000.0f) * 0.003f));
+}
+
+float Biome::getMoisture(glm::vec2 pos) {
+  const glm::vec2 spos = pos + g_settings.noise_offset;
+  return toUnit(glm::perlin((spos + 2000.0f) * 0.004f));
+}
+
+void Biome::sampleHeights(const float *x, const float *z, size_t n,
+                          int *height, float *biome_noise) {
+  // Same noise as getHeight(), one batch per noise layer.
+  thread_local std::vector<float> u, v, zero, continent, detail, biome, ocean;
+  for (auto *buf : {&u, &v, &zero, &continent, &detail, &biome, &ocean})
+    buf->resize(n);
+  std::fill(zero.begin(), zero.end(), 0.0f);
+  const glm::vec2 off = g_settings.noise_offset;
+
+  auto layer = [&](float freq, std::vector<float> &result) {
+    for (size_t i = 0; i < n; ++i) {
+      u[i] = (x[i] + off.x) * freq;
+      v[i] = (z[i] + off.y) * freq;
+    }
+    NoiseBatch::perlin2(u.data(), v.data(), result.data(), n);
+  };
+  layer(0.0008f, continent);
+  layer(0.0045f, biome);
+  layer(0.003f, ocean);
+  for (size_t i = 0; i < n; ++i) {
+    u[i] = (x[i] + off.x + 0.1f) * kBiomeFreq;
+    v[i] = (z[i] + off.y + 0.1f) * kBiomeFreq;
+  }
+  NoiseBatch::fbm3(u.data(), v.data(), zero.data(), detail.data(), n,
+                   int(kBiomeOctaves), kBiomeLacunarity, kBiomeGain);
+
+  for (size_t i = 0; i < n; ++i) {
+    biome_noise[i] = toUnit(biome[i]);
+    height[i] = shapeHeight(continent[i], detail[i], biome_noise[i], ocean[i]);
+  }
+}
+
+void Biome::sampleClimate(const float *x, const float *z, size_t n,
+                          float *temperature, float *moisture) {
+  // Same noise as getTemperature()/getMoisture().
+  thread_local std::vector<float> u, v;
+  u.resize(n);
+  v.resize(n);
+  const glm::vec2 off = g_settings.noise_offset;
+
+  auto layer = [&](float offset, float freq, float *result) {
+    for (size_t i = 0; i < n; ++i) {
+      u[i] = (x[i] + off.x + offset) * freq;
+      v[i] = (z[i] + off.y + offset) * freq;
+    }
+    NoiseBatch::perlin2(u.data(), v.data(), result, n);
+    for (size_t i = 0; i < n; ++i) result[i] = toUnit(result[i]);
+  };
+  layer(1000.0f, 0.003f, temperature);
+  layer(2000.0f, 0.004f, moisture);
+}
+
+void Biome::sampleColumns(int cx, int cz, ColumnSample *out) {
+  constexpr size_t N = kChunkWidth * kChunkDepth;
+  float x[N], z[N], biome_noise[N];
+  int height[N];
+  for (int lz = 0; lz < kChunkDepth; ++lz)
+    for (int lx = 0; lx < kChunkWidth; ++lx) {
+      const size_t i = lx + kChunkWidth * lz;
+      x[i] = float(cx * kChunkWidth + lx);
+      z[i] = float(cz * kChunkDepth + lz);
+    }
+  sampleHeights(x, z, N, height, biome_noise);
+  for (size_t i = 0; i < N; ++i) {
+    out[i].height = height[i];
+    out[i].biome_noise = biome_noise[i];
+  }
+}
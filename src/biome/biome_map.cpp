@@ -0,0 +1,78 @@
+#include "biome/biome_map.hpp"
+#include "biome/biome.hpp"
+#include "biome/biome_manager.hpp"
+#include "core/constants.hpp"
+#include "core/settings.hpp"
+#include "util/rng.hpp"
+#include <vector>
+
+void BiomeMap::chunkBiomes(int cx, int cz, BiomeType *out) {
+  // Keeps the jitter stream apart from the chunk streams, which share the
+  // seed and would otherwise reuse a chunk's first draw for one column.
+  constexpr uint64_t kJitterSalt = 0xB10E5EEDull;
+
+  std::shared_ptr<const Region> cached;
+  int cached_rx = 0, cached_rz = 0;
+  for (int lz = 0; lz < kChunkDepth; ++lz)
+    for (int lx = 0; lx < kChunkWidth; ++lx) {
+      const int wx = cx * kChunkWidth + lx;
+      const int wz = cz * kChunkDepth + lz;
+      // Up to two blocks off in each direction, fixed per column.
+      const uint32_t r = Rng(g_settings.world_seed ^ kJitterSalt, wx, wz).next();
+      const int ix = (wx + static_cast<int>(r & 3) - 2) >> kCellShift;
+      const int iz = (wz + static_cast<int>((r >> 2) & 3) - 2) >> kCellShift;
+      const int rx = ix >> kRegionShift, rz = iz >> kRegionShift;
+      if (!cached || rx != cached_rx || rz != cached_rz) {
+        cached = region(rx, rz);
+        cached_rx = rx;
+        cached_rz = rz;
+      }
+      out[lx + kChunkWidth * lz] =
+          (*cached)[(ix - (rx << kRegionShift)) +
+                    kRegionCells * (iz - (rz << kRegionShift))];
+    }
+}
+
+void BiomeMap::prune(int cx, int cz, int radius) {
+  constexpr int kRegionChunks = kRegionCells * kCellSize / kChunkWidth;
+  Lock lock(mutex);
+  for (auto it = regions.begin(); it != regions.end();) {
+    const int x0 = it->first.x * kRegionChunks, z0 = it->first.z * kRegionChunks;
+    const bool near = x0 + kRegionChunks > cx - radius && x0 <= cx + radius &&
+                      z0 + kRegionChunks > cz - radius && z0 <= cz + radius;
+    it = near ? std::next(it) : regions.erase(it);
+  }
+}
+
+std::shared_ptr<const BiomeMap::Region> BiomeMap::region(int rx, int rz) {
+  {
+    Lock lock(mutex);
+    auto it = regions.find({rx, rz});
+    if (it != regions.end()) return it->second;
+  }
+  // Computed unlocked; if two threads race here both get the same cells
+  // and the first to finish is kept.
+  auto computed = computeRegion(rx, rz);
+  Lock lock(mutex);
+  return regions.emplace(ChunkKey{rx, rz}, std::move(computed)).first->second;
+}
+
+std::shared_ptr<const BiomeMap::Region> BiomeMap::computeRegion(int rx, int rz) {
+  constexpr size_t N = kRegionCells * kRegionCells;
+  std::vector<float> x(N), z(N), biome_noise(N), temperature(N), moisture(N);
+  std::vector<int> height(N);
+  for (int j = 0; j < kRegionCells; ++j)
+    for (int i = 0; i < kRegionCells; ++i) {
+      const size_t c = i + kRegionCells * j;
+      x[c] = static_cast<float>((((rx << kRegionShift) + i) << kCellShift) + kCellSize / 2);
+      z[c] = static_cast<float>((((rz << kRegionShift) + j) << kCellShift) + kCellSize / 2);
+    }
+  Biome::sampleHeights(x.data(), z.data(), N, height.data(), biome_noise.data());
+  Biome::sampleClimate(x.data(), z.data(), N, temperature.data(), moisture.data());
+
+  auto region = std::make_shared<Region>();
+  for (size_t c = 0; c < N; ++c)
+    (*region)[c] = BiomeManager::classify(height[c], biome_noise[c],
+                                          temperature[c], moisture[c]);
+  return region;
+}
@@ -2,30 +2,15 @@
 #include "block/block_type.hpp"
 #include "core/constants.hpp"
 
-void CherryTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
-  auto safe_set = [&](int bx, int by, int bz, BlockType type) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      chunk.at(bx, by, bz) = type;
-    }
-  };
-
-  auto safe_set_blossom = [&](int bx, int by, int bz) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      BlockType cur = chunk.at(bx, by, bz);
-      if (cur == BlockType::AIR || cur == BlockType::CHERRY_LEAF)
-        chunk.at(bx, by, bz) = BlockType::CHERRY_LEAF;
-    }
-  };
-
+void CherryTreeGenerator::generate(DecorationCanvas &canvas, Rng &rng, int x,
+                                   int y, int z) {
   if (y <= 0 || y >= kChunkHeight - 16) return;
 
   // --- Trunk ---
   // Shorter than an oak: a cherry reads as a wide crown on a stubby trunk.
-  int h = (rand() % 2) + 4; // height 4-5
+  int h = rng.nextInt(2) + 4; // height 4-5
   for (int j = 1; j <= h; j++) {
-    safe_set(x, y + j, z, BlockType::CHERRY_LOG);
+    canvas.set(x, y + j, z, BlockType::CHERRY_LOG);
   }
 
   int fork_y = y + h; // trunk top, where the branches split off
@@ -37,8 +22,8 @@ void CherryTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
   const Dir dirs[8] = {{1, 0},  {-1, 0}, {0, 1},  {0, -1},
                        {1, 1},  {1, -1}, {-1, 1}, {-1, -1}};
 
-  int branch_count = 3 + (rand() % 2); // 3-4 branches
-  int start = rand() % 8;              // rotate which arms are used
+  int branch_count = 3 + rng.nextInt(2); // 3-4 branches
+  int start = rng.nextInt(8);            // rotate which arms are used
 
   // Tips are where the blossom clusters get centred.
   struct Tip { int x, y, z; };
@@ -46,14 +31,14 @@ void CherryTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
 
   for (int b = 0; b < branch_count; ++b) {
     const Dir &d = dirs[(start + b * 2) % 8];
-    int len = 2 + (rand() % 2); // 2-3 blocks out
+    int len = 2 + rng.nextInt(2); // 2-3 blocks out
 
     int bx = x, by = fork_y, bz = z;
     for (int i = 1; i <= len; ++i) {
       bx += d.dx;
       bz += d.dz;
       if (i % 2 == 1) by += 1; // rise every other step
-      safe_set(bx, by, bz, BlockType::CHERRY_LOG);
+      canvas.set(bx, by, bz, BlockType::CHERRY_LOG);
     }
     tips[b] = {bx, by, bz};
   }
@@ -77,9 +62,9 @@ void CherryTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
           if (dist_sq > r_sq) continue;
 
           // Thin the outer shell so the crown edge looks wispy, not solid.
-          if (dist_sq > r_sq - 1 && rand() % 3 == 0) continue;
+          if (dist_sq > r_sq - 1 && rng.nextInt(3) == 0) continue;
 
-          safe_set_blossom(t.x + dx, cy, t.z + dz);
+          canvas.fill(t.x + dx, cy, t.z + dz, BlockType::CHERRY_LEAF);
         }
       }
     }
@@ -91,7 +76,7 @@ void CherryTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
     for (int dx = -radius; dx <= radius; ++dx) {
       for (int dz = -radius; dz <= radius; ++dz) {
         if (dx * dx + dz * dz > radius * radius) continue;
-        safe_set_blossom(x + dx, cy, z + dz);
+        canvas.fill(x + dx, cy, z + dz, BlockType::CHERRY_LEAF);
       }
     }
   }
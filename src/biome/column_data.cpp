@@ -0,0 +1,15 @@
+#include "biome/column_data.hpp"
+#include "biome/biome.hpp"
+#include "biome/biome_map.hpp"
+
+void ColumnData::compute(int cx, int cz, BiomeMap &biomes) {
+  Biome::sampleColumns(cx, cz, columns.data());
+
+  std::array<BiomeType, kChunkWidth * kChunkDepth> types;
+  biomes.chunkBiomes(cx, cz, types.data());
+  present = 0;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    columns[i].biome = types[i];
+    present |= 1u << static_cast<unsigned>(types[i]);
+  }
+}
@@ -0,0 +1,64 @@
+#include "biome/decoration.hpp"
+#include "chunk/chunk.hpp"
+#include "core/constants.hpp"
+
+namespace {
+
+// -1 for blocks decorations never replace.
+int decorationRank(BlockType b) {
+  switch (b) {
+  case BlockType::AIR:
+    return 0;
+  case BlockType::OAK_LEAF:
+  case BlockType::PINE_LEAF:
+  case BlockType::PALM_LEAF:
+  case BlockType::CHERRY_LEAF:
+    return 1;
+  case BlockType::OAK_LOG:
+  case BlockType::PINE_LOG:
+  case BlockType::PALM_LOG:
+  case BlockType::CHERRY_LOG:
+    return 2;
+  default:
+    return -1;
+  }
+}
+
+} // namespace
+
+bool decorationReplaces(BlockType current, BlockType incoming) {
+  const int cur = decorationRank(current), in = decorationRank(incoming);
+  if (cur < 0) return false;
+  return in > cur || (in == cur && incoming > current);
+}
+
+bool DecorationCanvas::inside(int x, int z) const {
+  return x >= 0 && x < kChunkWidth && z >= 0 && z < kChunkDepth;
+}
+
+void DecorationCanvas::spill(int x, int y, int z, BlockType type) {
+  const glm::ivec2 pos = chunk.getPos();
+  overflow.push_back({{pos.x * kChunkWidth + x, y, pos.y * kChunkDepth + z}, type});
+}
+
+BlockType DecorationCanvas::at(int x, int y, int z) const {
+  if (!inside(x, z) || y < 0 || y >= kChunkHeight) return BlockType::AIR;
+  return chunk.at(x, y, z);
+}
+
+void DecorationCanvas::set(int x, int y, int z, BlockType type) {
+  if (y < 0 || y >= kChunkHeight) return;
+  if (inside(x, z))
+    chunk.setBlock(x, y, z, type);
+  else
+    spill(x, y, z, type);
+}
+
+void DecorationCanvas::fill(int x, int y, int z, BlockType type) {
+  if (y < 0 || y >= kChunkHeight) return;
+  if (!inside(x, z)) {
+    spill(x, y, z, type);
+    return;
+  }
+  if (chunk.at(x, y, z) == BlockType::AIR) chunk.setBlock(x, y, z, type);
+}
@@ -1,15 +1,20 @@
 #include "biome/desert_biome.hpp"
 #include "biome/palm_tree_generator.hpp"
 #include "block/block_type.hpp"
-#include <memory>
 
 DesertBiome::DesertBiome()
-    : palm_tree_spawner(0.93, std::make_unique<PalmTreeGenerator>()) {}
+    : Biome(BiomeType::DESERT),
+      palm_tree_spawner(0.93, PalmTreeGenerator::generate,
+                        [](const Chunk &chunk, int x, int y, int z) {
+                          return chunk.at(x, y, z) == BlockType::SAND;
+                        }) {}
 
-BlockType DesertBiome::generateTopBlock(int) { return BlockType::SAND; }
+BlockType DesertBiome::generateTopBlock(int, Rng &) const {
+  return BlockType::SAND;
+}
 
-void DesertBiome::spawnDecorations(Chunk &c) {
-  palm_tree_spawner.spawn(c, [](Chunk &chunk, int x, int y, int z) {
-    return chunk.at(x, y, z) == BlockType::SAND;
-  });
+void DesertBiome::spawnDecorations(Chunk &c, const ColumnData &columns,
+                                   std::vector<DecorationWrite> &overflow,
+                                   Rng &rng) const {
+  palm_tree_spawner.spawn(c, columns, type, overflow, rng);
 }
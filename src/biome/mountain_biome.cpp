@@ -4,20 +4,31 @@
 #include "block/block_type.hpp"
 #include "core/constants.hpp"
 
+namespace {
+
+bool onGrassBelowTreeLevel(const Chunk &chunk, int x, int y, int z) {
+  return chunk.at(x, y, z) == BlockType::GRASS && y < kTreeLevel;
+}
+
+} // namespace
+
 MountainBiome::MountainBiome()
-    : oak_tree_spawner(0.85, std::make_unique<OakTreeGenerator>()),
-      pine_tree_spawner(0.7, std::make_unique<PineTreeGenerator>()) {}
+    : Biome(BiomeType::MOUNTAIN),
+      oak_tree_spawner(0.85, OakTreeGenerator::generate, onGrassBelowTreeLevel),
+      pine_tree_spawner(0.7, PineTreeGenerator::generate,
+                        onGrassBelowTreeLevel) {
+  // Cliffs expose a lot of stone, so veins get a finer lattice.
+  ore_noise_spacing = 2;
+}
 
-BlockType MountainBiome::generateTopBlock(int) {
-  int rando = rand() % 10 + 1;
+BlockType MountainBiome::generateTopBlock(int, Rng &rng) const {
+  int rando = rng.nextInt(10) + 1;
   return rando >= 7 ? BlockType::DIRT : BlockType::GRASS;
 }
 
-void MountainBiome::spawnDecorations(Chunk &c) {
-  pine_tree_spawner.spawn(c, [](Chunk &chunk, int x, int y, int z) {
-    return chunk.at(x, y, z) == BlockType::GRASS && y < kTreeLevel;
-  });
-  oak_tree_spawner.spawn(c, [](Chunk &chunk, int x, int y, int z) {
-    return chunk.at(x, y, z) == BlockType::GRASS && y < kTreeLevel;
-  });
+void MountainBiome::spawnDecorations(Chunk &c, const ColumnData &columns,
+                                     std::vector<DecorationWrite> &overflow,
+                                     Rng &rng) const {
+  pine_tree_spawner.spawn(c, columns, type, overflow, rng);
+  oak_tree_spawner.spawn(c, columns, type, overflow, rng);
 }
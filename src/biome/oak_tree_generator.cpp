@@ -2,29 +2,14 @@
 #include "block/block_type.hpp"
 #include "core/constants.hpp"
 
-void OakTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
-  auto safe_set = [&](int bx, int by, int bz, BlockType type) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      chunk.at(bx, by, bz) = type;
-    }
-  };
-
-  auto safe_set_leaf = [&](int bx, int by, int bz) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      BlockType cur = chunk.at(bx, by, bz);
-      if (cur == BlockType::AIR || cur == BlockType::OAK_LEAF)
-        chunk.at(bx, by, bz) = BlockType::OAK_LEAF;
-    }
-  };
-
+void OakTreeGenerator::generate(DecorationCanvas &canvas, Rng &rng, int x,
+                                int y, int z) {
   if (y <= 0 || y >= kChunkHeight - 16) return;
 
   // --- Trunk ---
-  int h = (rand() % 3) + 5; // height 5-7
+  int h = rng.nextInt(3) + 5; // height 5-7
   for (int j = 1; j <= h; j++) {
-    safe_set(x, y + j, z, BlockType::OAK_LOG);
+    canvas.set(x, y + j, z, BlockType::OAK_LOG);
   }
 
   // --- Canopy: layered approach for a natural rounded crown ---
@@ -51,9 +36,9 @@ void OakTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
         if (dist_sq > r_sq) continue;
 
         // Slight random skip at the edges only (10% chance) for natural look
-        if (dist_sq > r_sq * 0.7f && rand() % 10 == 0) continue;
+        if (dist_sq > r_sq * 0.7f && rng.nextInt(10) == 0) continue;
 
-        safe_set_leaf(x + dx, cy, z + dz);
+        canvas.fill(x + dx, cy, z + dz, BlockType::OAK_LEAF);
       }
     }
   }
@@ -1,12 +1,13 @@
 #include "biome/ocean_biome.hpp"
 #include "block/block_type.hpp"
 
-OceanBiome::OceanBiome() {
-}
+OceanBiome::OceanBiome() : Biome(BiomeType::OCEAN) {}
 
-BlockType OceanBiome::generateTopBlock(int) {
+BlockType OceanBiome::generateTopBlock(int, Rng &) const {
     return BlockType::SANDSTONE;
 }
 
-void OceanBiome::spawnDecorations(Chunk&) {
+void OceanBiome::spawnDecorations(Chunk &, const ColumnData &,
+                                  std::vector<DecorationWrite> &,
+                                  Rng &) const {
 }
@@ -3,30 +3,29 @@
 #include "core/constants.hpp"
 #include <cmath>
 
-void PalmTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
+void PalmTreeGenerator::generate(DecorationCanvas &canvas, Rng &rng, int x,
+                                 int y, int z) {
+  // Palms only grow into air or their own fronds.
   auto safe_set = [&](int bx, int by, int bz, BlockType type) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      if (chunk.at(bx, by, bz) == BlockType::AIR ||
-          chunk.at(bx, by, bz) == BlockType::PALM_LEAF)
-        chunk.at(bx, by, bz) = type;
-    }
+    const BlockType cur = canvas.at(bx, by, bz);
+    if (cur == BlockType::AIR || cur == BlockType::PALM_LEAF)
+      canvas.set(bx, by, bz, type);
   };
 
   // --- Base checks ---
   if (y <= 0 || y >= kChunkHeight - 16) return;
-  if (chunk.at(x, y - 1, z) == BlockType::AIR) return;
+  if (canvas.at(x, y - 1, z) == BlockType::AIR) return;
 
-  int h = (rand() % 4) + 7; // height 7-10
+  int h = rng.nextInt(4) + 7; // height 7-10
 
   // Slight lean: pick a random direction and lean gently
-  int lean_dx = (rand() % 3) - 1;
-  int lean_dz = (rand() % 3) - 1;
+  int lean_dx = rng.nextInt(3) - 1;
+  int lean_dz = rng.nextInt(3) - 1;
   if (lean_dx == 0 && lean_dz == 0) lean_dx = 1;
 
   float fx = static_cast<float>(x);
   float fz = static_cast<float>(z);
-  float lean_rate = 0.12f + (rand() % 3) * 0.04f; // 0.12 - 0.20
+  float lean_rate = 0.12f + rng.nextInt(3) * 0.04f; // 0.12 - 0.20
 
   // --- Trunk (slight lean, slowing near top) ---
   // Track previous integer position so we can fill gaps when the trunk
@@ -85,7 +84,7 @@ void PalmTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
   struct FrondDir { int dx, dz; };
   FrondDir frond_dirs[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
 
-  int frond_len = 3 + (rand() % 2); // 3-4 blocks long
+  int frond_len = 3 + rng.nextInt(2); // 3-4 blocks long
 
   for (auto &dir : frond_dirs) {
     for (int i = 1; i <= frond_len; ++i) {
@@ -112,7 +111,7 @@ void PalmTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
 
   // --- Diagonal fronds (4 more, shorter) for fullness ---
   FrondDir diag_dirs[4] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-  int diag_len = 2 + (rand() % 2); // 2-3 blocks
+  int diag_len = 2 + rng.nextInt(2); // 2-3 blocks
 
   for (auto &dir : diag_dirs) {
     for (int i = 1; i <= diag_len; ++i) {
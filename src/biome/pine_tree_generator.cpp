@@ -2,30 +2,15 @@
 #include "block/block_type.hpp"
 #include "core/constants.hpp"
 
-void PineTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
-  auto safe_set = [&](int bx, int by, int bz, BlockType type) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      chunk.at(bx, by, bz) = type;
-    }
-  };
-
-  auto safe_set_leaf = [&](int bx, int by, int bz) {
-    if (bx >= 0 && bx < kChunkWidth && by >= 0 && by < kChunkHeight &&
-        bz >= 0 && bz < kChunkDepth) {
-      BlockType cur = chunk.at(bx, by, bz);
-      if (cur == BlockType::AIR || cur == BlockType::PINE_LEAF)
-        chunk.at(bx, by, bz) = BlockType::PINE_LEAF;
-    }
-  };
-
+void PineTreeGenerator::generate(DecorationCanvas &canvas, Rng &rng, int x,
+                                 int y, int z) {
   if (y <= 0 || y >= kChunkHeight - 20) return;
 
-  int h = (rand() % 5) + 10; // height 10-14
+  int h = rng.nextInt(5) + 10; // height 10-14
 
   // --- Trunk ---
   for (int j = 1; j <= h; j++) {
-    safe_set(x, y + j, z, BlockType::PINE_LOG);
+    canvas.set(x, y + j, z, BlockType::PINE_LOG);
   }
 
   // --- Conical canopy with tiered layers ---
@@ -53,14 +38,14 @@ void PineTreeGenerator::generate(Chunk &chunk, int x, int y, int z) {
         if (dist_sq > r_sq) continue;
 
         // Light random skip at outer edges only (8% chance)
-        if (dist_sq > r_sq * 0.6f && rand() % 12 == 0) continue;
+        if (dist_sq > r_sq * 0.6f && rng.nextInt(12) == 0) continue;
 
-        safe_set_leaf(x + dx, cy, z + dz);
+        canvas.fill(x + dx, cy, z + dz, BlockType::PINE_LEAF);
       }
     }
   }
 
   // --- Top spike ---
-  safe_set_leaf(x, y + h + 1, z);
-  safe_set_leaf(x, y + h + 2, z);
+  canvas.fill(x, y + h + 1, z, BlockType::PINE_LEAF);
+  canvas.fill(x, y + h + 2, z, BlockType::PINE_LEAF);
 }
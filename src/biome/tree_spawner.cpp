@@ -4,24 +4,24 @@
 #include "core/settings.hpp"
 #include <glm/gtc/noise.hpp>
 
-TreeSpawner::TreeSpawner(double den, std::unique_ptr<TreeGenerator> gen)
-    : density(den), generator(std::move(gen)) {}
-
-void TreeSpawner::spawn(
-    Chunk &chunk, std::function<bool(Chunk &, int, int, int)> isValidSpawn) {
+void TreeSpawner::spawn(Chunk &chunk, const ColumnData &columns,
+                        BiomeType biome,
+                        std::vector<DecorationWrite> &overflow,
+                        Rng &rng) const {
   glm::vec2 pos = chunk.getPos();
+  DecorationCanvas canvas(chunk, overflow);
+
+  for (int x = 0; x < kChunkWidth; ++x) {
+    for (int z = 0; z < kChunkDepth; ++z) {
+      if (columns.at(x, z).biome != biome) continue;
 
-  for (int x = kBiomeTreeBorder; x <= kChunkWidth - 1 - kBiomeTreeBorder; ++x) {
-    for (int z = kBiomeTreeBorder; z <= kChunkDepth - 1 - kBiomeTreeBorder;
-         ++z) {
-      // Find the topmost non-air block (skip water too)
-      int y = 0;
-      for (int i = kChunkHeight - 1; i > 0; --i) {
-        BlockType b = chunk.at(x, i, z);
-        if (b != BlockType::AIR && b != BlockType::WATER) {
-          y = i;
-          break;
-        }
+      // Find the topmost non-air block (skip water too), starting from the
+      // heightmap rather than the top of the chunk.
+      int y = chunk.topNonAir(x, z);
+      while (y > 0) {
+        BlockType b = chunk.at(x, y, z);
+        if (b != BlockType::AIR && b != BlockType::WATER) break;
+        --y;
       }
 
       if (y <= 0) continue;
@@ -39,7 +39,7 @@ void TreeSpawner::spawn(
           0.5;
 
       if (tree_noise > density) {
-        generator->generate(chunk, x, y, z);
+        generator(canvas, rng, x, y, z);
       }
     }
   }
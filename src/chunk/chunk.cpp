@@ -1,54 +1,166 @@
 #include "chunk/chunk.hpp"
+#include "chunk/chunk_snapshot.hpp"
 #include "block/block_data.hpp"
 #include "render/texture_manager.hpp"
 #include "biome/biome_manager.hpp"
 #include "core/constants.hpp"
-#include <queue>
+#include "core/settings.hpp"
+#include "util/ring_queue.hpp"
+#include "util/rng.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 Chunk::Chunk(int x, int z)
     : pos({x, z}),
-      blocks(kChunkWidth * kChunkHeight * kChunkDepth, BlockType::AIR),
-      skylight(kChunkWidth * kChunkHeight * kChunkDepth, 0),
-      blocklight(kChunkWidth * kChunkHeight * kChunkDepth, 0) {}
+      light(kChunkWidth * kChunkHeight * kChunkDepth, 0) {
+  top_non_air.fill(-1);
+  top_opaque.fill(-1);
+}
 
 
 
-void Chunk::init() {
-  BiomeType biome_type = BiomeManager::getBiomeForChunk(pos[0], pos[1]);
-  std::unique_ptr<Biome> biome = BiomeManager::createBiome(biome_type);
-  biome->generateTerrain(*this);
-  biome->generateMinerals(*this);
-  biome->fillWater(*this);
-  biome->spawnDecorations(*this);
+void Chunk::generate(BiomeMap &biomes, std::vector<DecorationWrite> &overflow) {
+  ColumnData columns;
+  columns.compute(pos[0], pos[1], biomes);
+  // Minerals follow the biome at the chunk's centre.
+  const Biome &biome =
+      BiomeManager::getBiome(columns.at(kChunkWidth / 2, kChunkDepth / 2).biome);
+  // Seeded per chunk, so the result never depends on which thread generated
+  // it or what was generated before.
+  Rng rng(g_settings.world_seed, pos[0], pos[1]);
+  Biome::generateTerrain(*this, columns, rng);
+  biome.generateMinerals(*this, rng);
+  biome.fillWater(*this);
+  advanceState(ChunkState::Queued, ChunkState::Generated);
+  // Every biome in the chunk decorates its own columns, in BiomeType order.
+  for (int t = 0; t < kBiomeTypeCount; ++t) {
+    const BiomeType type = static_cast<BiomeType>(t);
+    if (columns.hasBiome(type))
+      BiomeManager::getBiome(type).spawnDecorations(*this, columns, overflow, rng);
+  }
+  advanceState(ChunkState::Generated, ChunkState::Decorated);
+}
+
+void Chunk::finalize() {
   computeSkyLight();
   computeBlockLight();
+  compact();
+  advanceState(ChunkState::Decorated, ChunkState::Lit);
+}
+
+void Chunk::init(BiomeMap &biomes) {
+  std::vector<DecorationWrite> overflow;
+  generate(biomes, overflow);
+  finalize();
+}
+
+size_t ChunkBlocks::memoryUsage() const {
+  size_t total = sizeof(top_non_air) + sizeof(top_opaque);
+  for (const auto &section : sections) total += section.memoryUsage();
+  return total;
+}
+
+ChunkBlocks Chunk::copyBlocks() const {
+  return {sections, top_non_air, top_opaque};
+}
+
+void Chunk::restoreBlocks(ChunkBlocks &&blocks) {
+  sections = std::move(blocks.sections);
+  top_non_air = blocks.top_non_air;
+  top_opaque = blocks.top_opaque;
+  advanceState(ChunkState::Queued, ChunkState::Generated);
+  advanceState(ChunkState::Generated, ChunkState::Decorated);
 }
 
 void Chunk::buildMeshData(World* world, TextureManager& texture_manager) {
-  std::lock_guard lock(data_mutex);
-  mesh.generateCPU(world, *this, texture_manager); // CPU-only
+  // Copy this chunk plus its neighbours' border voxels (each chunk locked only
+  // while it is copied), then mesh from the copy without touching any locks.
+  thread_local ChunkSnapshot snapshot;
+  snapshot.capture(world, *this);
+
+  std::lock_guard lock(mesh_mutex);
+  mesh.generateCPU(snapshot, texture_manager); // CPU-only
 }
 
 void Chunk::uploadGPU() {
+  // A worker is rebuilding the mesh right now; it re-queues the chunk for
+  // upload when it finishes, so just skip this one.
+  std::unique_lock lock(mesh_mutex, std::try_to_lock);
+  if (!lock.owns_lock()) return;
   mesh.upload();
+  setState(ChunkState::Uploaded);
+}
+
+BlockType Chunk::at(int x, int y, int z) const {
+  return atLinear(x + kChunkWidth * (z + kChunkDepth * y));
 }
 
-BlockType &Chunk::at(int x, int y, int z) {
-  return blocks[x + kChunkWidth * (z + kChunkDepth * y)];
+BlockType Chunk::atLinear(uint32_t i) const {
+  return sections[i / kSectionVolume].get(i % kSectionVolume);
 }
 
-const BlockType &Chunk::at(int x, int y, int z) const {
-  return blocks[x + kChunkWidth * (z + kChunkDepth * y)];
+void Chunk::setBlock(int x, int y, int z, BlockType type) {
+  const uint32_t i = x + kChunkWidth * (z + kChunkDepth * y);
+  sections[i / kSectionVolume].set(i % kSectionVolume, type);
+  updateHeightmap(x, y, z, type);
 }
 
 void Chunk::setBlockLinear(uint32_t index, BlockType type) {
-  if (index < blocks.size())
-    blocks[index] = type;
+  if (index >= static_cast<uint32_t>(kSectionCount * kSectionVolume)) return;
+  sections[index / kSectionVolume].set(index % kSectionVolume, type);
+  const int column = index % (kChunkWidth * kChunkDepth);
+  updateHeightmap(column % kChunkWidth, index / (kChunkWidth * kChunkDepth),
+                  column / kChunkWidth, type);
+}
+
+void Chunk::updateHeightmap(int x, int y, int z, BlockType type) {
+  auto update = [&](int16_t &top, bool counts, auto predicate) {
+    if (counts) {
+      if (y > top) top = static_cast<int16_t>(y);
+    } else if (y == top) {
+      // The top block went away: walk down to the next one that counts.
+      int ny = y - 1;
+      while (ny >= 0 && !predicate(at(x, ny, z))) --ny;
+      top = static_cast<int16_t>(ny);
+    }
+  };
+  auto nonAir = [](BlockType b) { return b != BlockType::AIR; };
+  auto opaque = [](BlockType b) { return skyLightOpacity(b) >= 15; };
+
+  const int column = x + kChunkWidth * z;
+  update(top_non_air[column], nonAir(type), nonAir);
+  update(top_opaque[column], opaque(type), opaque);
+}
+
+int Chunk::maxHeight() const {
+  int top = -1;
+  for (int16_t h : top_non_air) top = std::max<int>(top, h);
+  return top;
+}
+
+void Chunk::compact() {
+  for (auto &section : sections) section.compact(g_settings.palette_storage);
+}
+
+void Chunk::decodeBlocks(BlockType *out) const {
+  for (int s = 0; s < kSectionCount; ++s)
+    sections[s].decode(out + s * kSectionVolume);
+}
+
+size_t Chunk::blockMemoryUsage() const {
+  size_t total = 0;
+  for (const auto &section : sections) total += section.memoryUsage();
+  return total;
 }
 
 void Chunk::setBlockLightLinear(uint32_t index, uint8_t value) {
-  if (index < blocklight.size())
-    blocklight[index] = value;
+  if (index < light.size())
+    setBlockNibble(index, value);
 }
 
 BlockType Chunk::safeAt(int x, int y, int z) const {
@@ -64,139 +176,249 @@ glm::mat4 Chunk::getModelMatrix() const {
                         glm::vec3(pos[0] * kChunkWidth, 0, pos[1] * kChunkDepth));
 }
 
-uint8_t Chunk::getSkyLight(int x, int y, int z) const {
-  return skylight[x + kChunkWidth * (z + kChunkDepth * y)];
-}
-
-uint8_t Chunk::safeSkyLight(int x, int y, int z) const {
+uint8_t Chunk::safeLight(int x, int y, int z) const {
   if (x < 0 || x >= kChunkWidth || y < 0 || y >= kChunkHeight ||
       z < 0 || z >= kChunkDepth)
     return 0;
-  return getSkyLight(x, y, z);
+  return getLight(x, y, z);
 }
 
-void Chunk::computeSkyLight() {
-  std::fill(skylight.begin(), skylight.end(), 0);
+namespace {
 
-  using Queue = std::queue<std::tuple<int,int,int>>;
-  Queue queue;
+constexpr int kLayer = kChunkWidth * kChunkDepth;
 
-  // Phase 1 — top-down column scan.
-  // Sky light (value 15) propagates straight down through transparent blocks.
-  // Semi-transparent blocks (leaves, water) absorb some levels.
-  for (int z = 0; z < kChunkDepth; ++z) {
-    for (int x = 0; x < kChunkWidth; ++x) {
-      uint8_t light = 15;
-      for (int y = kChunkHeight - 1; y >= 0 && light > 0; --y) {
-        BlockType b = at(x, y, z);
-        uint8_t opacity = skyLightOpacity(b);
-        if (opacity >= 15) break; // fully opaque — stop column
-        if (opacity > 0) {
-          light = (light > opacity) ? light - opacity : 0;
-        }
-        int idx = x + kChunkWidth * (z + kChunkDepth * y);
-        skylight[idx] = light;
-        if (light > 0)
-          queue.push({x, y, z});
+// Light BFS queue of packed linear voxel indices, reused by every relight on
+// this thread.
+RingQueue<uint32_t> &lightQueue() {
+  thread_local RingQueue<uint32_t> queue(1 << 14);
+  queue.clear();
+  return queue;
+}
+
+// Flood-fills one light channel from the queued voxels. `get`/`set` access
+// that channel's nibble and `opacity` the block at a linear index. Each hop
+// decays by 1; semi-transparent blocks decay by 1+opacity, opaque ones stop
+// light.
+template <class Get, class Set, class Opacity>
+void floodLight(RingQueue<uint32_t> &queue, Get get, Set set, Opacity opacity) {
+  while (!queue.empty()) {
+    const uint32_t i = queue.pop();
+    const uint8_t level = get(i);
+    if (level <= 1) continue;
+
+    auto visit = [&](uint32_t n) {
+      const uint8_t op = opacity(n);
+      if (op >= 15 || level <= 1 + op) return;
+      const uint8_t next = static_cast<uint8_t>(level - 1 - op);
+      if (next > get(n)) {
+        set(n, next);
+        queue.push(n);
       }
-    }
+    };
+    // Neighbours by index delta; the coordinate checks keep steps in-chunk.
+    const uint32_t x = i % kChunkWidth;
+    const uint32_t z = (i / kChunkWidth) % kChunkDepth;
+    const uint32_t y = i / kLayer;
+    if (x > 0)                visit(i - 1);
+    if (x < kChunkWidth - 1)  visit(i + 1);
+    if (y > 0)                visit(i - kLayer);
+    if (y < kChunkHeight - 1) visit(i + kLayer);
+    if (z > 0)                visit(i - kChunkWidth);
+    if (z < kChunkDepth - 1)  visit(i + kChunkWidth);
   }
+}
 
-  // Phase 2 — BFS flood fill.
-  // Spreads light horizontally (and upward) under overhangs / into cave mouths.
-  static constexpr int DX[6] = {-1, 1,  0, 0,  0, 0};
-  static constexpr int DY[6] = { 0, 0, -1, 1,  0, 0};
-  static constexpr int DZ[6] = { 0, 0,  0, 0, -1, 1};
+// Sky opacity of every block type, for table lookups instead of the switch.
+const std::array<uint8_t, 256> kSkyOpacity = [] {
+  std::array<uint8_t, 256> table{};
+  for (int t = 0; t < 256; ++t)
+    table[t] = skyLightOpacity(static_cast<BlockType>(t));
+  return table;
+}();
+
+// ─── Layer kernels (one 16x16 horizontal layer, x fastest) ──────────────────
+// SSE2 (AVX2 where enabled) with a scalar fallback. A 16-byte vector is
+// exactly one row of 16 columns along x.
+
+// level = level - opacity (saturating) for all 256 columns. Opacity 15 takes
+// any level to 0 for good. Returns whether any column is still lit.
+bool dimLayer(uint8_t *level, const uint8_t *opacity) {
+#if defined(__AVX2__)
+  __m256i lit = _mm256_setzero_si256();
+  for (int i = 0; i < kLayer; i += 32) {
+    auto *p = reinterpret_cast<__m256i *>(level + i);
+    const __m256i v = _mm256_subs_epu8(
+        _mm256_load_si256(p),
+        _mm256_load_si256(reinterpret_cast<const __m256i *>(opacity + i)));
+    _mm256_store_si256(p, v);
+    lit = _mm256_or_si256(lit, v);
+  }
+  return !_mm256_testz_si256(lit, lit);
+#elif defined(__SSE2__)
+  __m128i lit = _mm_setzero_si128();
+  for (int i = 0; i < kLayer; i += 16) {
+    auto *p = reinterpret_cast<__m128i *>(level + i);
+    const __m128i v = _mm_subs_epu8(
+        _mm_load_si128(p),
+        _mm_load_si128(reinterpret_cast<const __m128i *>(opacity + i)));
+    _mm_store_si128(p, v);
+    lit = _mm_or_si128(lit, v);
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(lit, _mm_setzero_si128())) != 0xFFFF;
+#else
+  uint8_t lit = 0;
+  for (int i = 0; i < kLayer; ++i) {
+    level[i] = level[i] > opacity[i] ? level[i] - opacity[i] : 0;
+    lit |= level[i];
+  }
+  return lit != 0;
+#endif
+}
 
-  while (!queue.empty()) {
-    auto [x, y, z] = queue.front();
-    queue.pop();
-    uint8_t light = skylight[x + kChunkWidth * (z + kChunkDepth * y)];
-    if (light <= 1) continue;
-
-    for (int d = 0; d < 6; ++d) {
-      int nx = x + DX[d], ny = y + DY[d], nz = z + DZ[d];
-      if (nx < 0 || nx >= kChunkWidth || ny < 0 || ny >= kChunkHeight ||
-          nz < 0 || nz >= kChunkDepth) continue;
-
-      BlockType nb = at(nx, ny, nz);
-      uint8_t opacity = skyLightOpacity(nb);
-      if (opacity >= 15) continue;
-
-      // Each hop decays by 1; semi-transparent blocks decay by 1+opacity
-      uint8_t cost = 1 + opacity;
-      uint8_t newLight = (light > cost) ? static_cast<uint8_t>(light - cost) : 0;
-      if (newLight == 0) continue;
-
-      int idx = nx + kChunkWidth * (nz + kChunkDepth * ny);
-      if (newLight > skylight[idx]) {
-        skylight[idx] = newLight;
-        queue.push({nx, ny, nz});
-      }
-    }
+// Writes `level` into the sky nibbles of one layer of packed light.
+void storeSkyLayer(uint8_t *light, const uint8_t *level) {
+#if defined(__SSE2__)
+  const __m128i low = _mm_set1_epi8(0x0F), high = _mm_set1_epi8(char(0xF0));
+  for (int i = 0; i < kLayer; i += 16) {
+    auto *p = reinterpret_cast<__m128i *>(light + i);
+    const __m128i sky = _mm_and_si128(
+        _mm_slli_epi16(_mm_load_si128(reinterpret_cast<const __m128i *>(level + i)), 4),
+        high);
+    _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(_mm_loadu_si128(p), low), sky));
   }
+#else
+  for (int i = 0; i < kLayer; ++i)
+    light[i] = static_cast<uint8_t>((light[i] & 0x0F) | (level[i] << 4));
+#endif
 }
 
-uint8_t Chunk::getBlockLight(int x, int y, int z) const {
-  return blocklight[x + kChunkWidth * (z + kChunkDepth * y)];
+// Calls seed(i) for every voxel of the layer whose column light can raise a
+// horizontal neighbour (level > neighbour level + 1 + neighbour opacity).
+// Vertical neighbours never need it: column light only dims going down.
+template <class F>
+void seedLayer(const uint8_t *level, const uint8_t *opacity, F &&seed) {
+#if defined(__SSE2__)
+  // What it takes to raise each voxel; >= 16 (never) through opaque blocks.
+  __m128i need[kChunkDepth];
+  const __m128i one = _mm_set1_epi8(1);
+  for (int z = 0; z < kChunkDepth; ++z)
+    need[z] = _mm_adds_epu8(
+        _mm_load_si128(reinterpret_cast<const __m128i *>(level + z * 16)),
+        _mm_adds_epu8(_mm_load_si128(reinterpret_cast<const __m128i *>(opacity + z * 16)), one));
+
+  const __m128i none = _mm_set1_epi8(char(0xFF));
+  const __m128i first = _mm_srli_si128(none, 15); // 0xFF in lane 0 only
+  const __m128i last = _mm_slli_si128(none, 15);  // 0xFF in lane 15 only
+  for (int z = 0; z < kChunkDepth; ++z) {
+    __m128i lowest = _mm_min_epu8(_mm_or_si128(_mm_slli_si128(need[z], 1), first),
+                                  _mm_or_si128(_mm_srli_si128(need[z], 1), last));
+    if (z > 0) lowest = _mm_min_epu8(lowest, need[z - 1]);
+    if (z < kChunkDepth - 1) lowest = _mm_min_epu8(lowest, need[z + 1]);
+    const __m128i row = _mm_load_si128(reinterpret_cast<const __m128i *>(level + z * 16));
+    unsigned bits = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_subs_epu8(row, lowest),
+                                                      _mm_setzero_si128())) & 0xFFFF;
+    for (; bits; bits &= bits - 1)
+      seed(z * 16 + std::countr_zero(bits));
+  }
+#else
+  auto need = [&](int x, int z) {
+    const int i = x + kChunkWidth * z;
+    return level[i] + 1 + opacity[i];
+  };
+  for (int z = 0; z < kChunkDepth; ++z)
+    for (int x = 0; x < kChunkWidth; ++x) {
+      const int l = level[x + kChunkWidth * z];
+      if ((x > 0 && l > need(x - 1, z)) || (x < kChunkWidth - 1 && l > need(x + 1, z)) ||
+          (z > 0 && l > need(x, z - 1)) || (z < kChunkDepth - 1 && l > need(x, z + 1)))
+        seed(x + kChunkWidth * z);
+    }
+#endif
 }
 
-uint8_t Chunk::safeBlockLight(int x, int y, int z) const {
-  if (x < 0 || x >= kChunkWidth || y < 0 || y >= kChunkHeight ||
-      z < 0 || z >= kChunkDepth)
-    return 0;
-  return getBlockLight(x, y, z);
+} // namespace
+
+void Chunk::computeSkyLight() {
+  for (auto &l : light) l &= 0x0F; // clear sky, keep block light
+
+  RingQueue<uint32_t> &queue = lightQueue();
+
+  // Empty sections above the terrain are open sky: fill them in bulk. They
+  // need no BFS seeds — every non-opaque voxel right below them already gets
+  // more light from its column than a sideways/downward hop could give it.
+  int open_from = kChunkHeight;
+  for (int s = kSectionCount - 1; s >= 0 && sections[s].isEmpty(); --s)
+    open_from = s * kSectionHeight;
+  for (size_t i = open_from * kChunkWidth * kChunkDepth; i < light.size(); ++i)
+    light[i] |= 0xF0;
+
+  // Phase 1 — top-down column scan, one 16x16 layer at a time.
+  // Sky light (value 15) propagates straight down through transparent blocks.
+  // Semi-transparent blocks (leaves, water) absorb some levels; opaque ones
+  // stop the column. Only voxels that can light a darker horizontal
+  // neighbour seed the BFS.
+  alignas(32) uint8_t level[kLayer];
+  alignas(32) uint8_t opacity[kLayer];
+  std::memset(level, 15, sizeof(level));
+  BlockType section_blocks[kSectionVolume];
+  int decoded = -1;
+  for (int y = open_from - 1; y >= 0; --y) {
+    const int s = y / kSectionHeight;
+    const ChunkSection &section = sections[s];
+    if (section.isUniform()) {
+      std::memset(opacity, kSkyOpacity[static_cast<uint8_t>(section.uniformType())],
+                  sizeof(opacity));
+    } else {
+      if (decoded != s) {
+        section.decode(section_blocks);
+        decoded = s;
+      }
+      const BlockType *row = section_blocks + (y % kSectionHeight) * kLayer;
+      for (int i = 0; i < kLayer; ++i)
+        opacity[i] = kSkyOpacity[static_cast<uint8_t>(row[i])];
+    }
+
+    if (!dimLayer(level, opacity)) break; // every column is dark from here
+    storeSkyLayer(light.data() + kLayer * y, level);
+    seedLayer(level, opacity, [&](int i) { queue.push(kLayer * y + i); });
+  }
+
+  // Phase 2 — BFS flood fill.
+  // Spreads light horizontally (and upward) under overhangs / into cave mouths.
+  floodLight(
+      queue, [&](uint32_t i) { return skyNibble(i); },
+      [&](uint32_t i, uint8_t v) { setSkyNibble(i, v); },
+      [&](uint32_t i) { return skyLightOpacity(atLinear(i)); });
 }
 
 void Chunk::computeBlockLight() {
-  std::fill(blocklight.begin(), blocklight.end(), 0);
+  for (auto &l : light) l &= 0xF0; // clear block light, keep sky
 
-  using Queue = std::queue<std::tuple<int, int, int>>;
-  Queue queue;
+  RingQueue<uint32_t> &queue = lightQueue();
 
   // Seed the BFS with every emissive block at its emission level. This is the
-  // intra-chunk pass; the World runs a cross-chunk relight over the surrounding
-  // chunks when emitters are present (see World::relightBlockRegion).
+  // intra-chunk pass; the World stitches light across borders when emitters
+  // are present (see LightEngine::stitchLight).
   emitter_count = 0;
-  for (int y = 0; y < kChunkHeight; ++y)
-    for (int z = 0; z < kChunkDepth; ++z)
-      for (int x = 0; x < kChunkWidth; ++x) {
-        uint8_t emit = blockLightEmission(at(x, y, z));
-        if (emit > 0) {
-          ++emitter_count;
-          blocklight[x + kChunkWidth * (z + kChunkDepth * y)] = emit;
-          queue.push({x, y, z});
-        }
-      }
-
-  static constexpr int DX[6] = {-1, 1, 0, 0, 0, 0};
-  static constexpr int DY[6] = {0, 0, -1, 1, 0, 0};
-  static constexpr int DZ[6] = {0, 0, 0, 0, -1, 1};
-
-  while (!queue.empty()) {
-    auto [x, y, z] = queue.front();
-    queue.pop();
-    uint8_t light = blocklight[x + kChunkWidth * (z + kChunkDepth * y)];
-    if (light <= 1) continue;
-
-    for (int d = 0; d < 6; ++d) {
-      int nx = x + DX[d], ny = y + DY[d], nz = z + DZ[d];
-      if (nx < 0 || nx >= kChunkWidth || ny < 0 || ny >= kChunkHeight ||
-          nz < 0 || nz >= kChunkDepth) continue;
-
-      // Opaque blocks stop light; semi-transparent ones cost extra.
-      uint8_t opacity = skyLightOpacity(at(nx, ny, nz));
-      if (opacity >= 15) continue;
-
-      uint8_t cost = 1 + opacity;
-      uint8_t newLight = (light > cost) ? static_cast<uint8_t>(light - cost) : 0;
-      if (newLight == 0) continue;
-
-      int idx = nx + kChunkWidth * (nz + kChunkDepth * ny);
-      if (newLight > blocklight[idx]) {
-        blocklight[idx] = newLight;
-        queue.push({nx, ny, nz});
+  const int max_height = maxHeight();
+  for (int y = 0; y <= max_height; ++y) {
+    const ChunkSection &section = sections[y / kSectionHeight];
+    if (section.isUniform() && blockLightEmission(section.uniformType()) == 0) {
+      y += kSectionHeight - 1;
+      continue;
+    }
+    for (uint32_t i = kLayer * y; i < kLayer * (y + 1u); ++i) {
+      uint8_t emit = blockLightEmission(atLinear(i));
+      if (emit > 0) {
+        ++emitter_count;
+        setBlockNibble(i, emit);
+        queue.push(i);
       }
     }
   }
+
+  // Opaque blocks stop light; semi-transparent ones cost extra.
+  floodLight(
+      queue, [&](uint32_t i) { return blockNibble(i); },
+      [&](uint32_t i, uint8_t v) { setBlockNibble(i, v); },
+      [&](uint32_t i) { return skyLightOpacity(atLinear(i)); });
 }
@@ -1,9 +1,12 @@
 #include "chunk/chunk_mesh.hpp"
 #include "block/block_data.hpp"
 #include "chunk/chunk.hpp"
+#include "chunk/chunk_snapshot.hpp"
 #include "core/constants.hpp"
-#include "world/world.hpp"
+#include "core/settings.hpp"
+#include <algorithm>
 #include <array>
+#include <bit>
 
 namespace {
 
@@ -37,14 +40,45 @@ inline bool shouldRenderFace(BlockType current, BlockType neighbor) {
 
 // ─── Ambient Occlusion ─────────────────────────────────────────────────
 
-// Returns true if the block at (x,y,z) should occlude for AO purposes.
-// Opaque blocks occlude; transparent/air do not.
-inline bool isAOSolid(World* world, const Chunk& chunk, int x, int y, int z) {
-  BlockType b = ChunkMesh::getBlock(world, chunk, x, y, z);
+// Fully opaque, non-cutout blocks: they hide any face pressed against them.
+inline bool isOccluder(BlockType b) {
   return b != BlockType::AIR && !isTransparent(b) && !isLiquid(b) &&
          !isCutout(b);
 }
 
+// Returns true if the block at (x,y,z) should occlude for AO purposes.
+// Opaque blocks occlude; transparent/air do not.
+inline bool isAOSolid(const ChunkSnapshot& snap, int x, int y, int z) {
+  return isOccluder(snap.block(x, y, z));
+}
+
+// ─── Section culling ───────────────────────────────────────────────────
+
+// True if section s cannot emit a single face: all air, a uniform occluder
+// walled in by uniform occluders on all six sides, or uniform water under
+// more water (water only ever emits top faces).
+bool canSkipSection(const ChunkSnapshot& snap, int s) {
+  const int type = snap.sectionUniform(0, s);
+  if (type < 0) return false;
+  if (type == static_cast<int>(BlockType::AIR)) return true;
+
+  auto uniformOccluder = [&](int side, int sec) {
+    const int t = snap.sectionUniform(side, sec);
+    return t >= 0 && isOccluder(static_cast<BlockType>(t));
+  };
+
+  if (isLiquid(static_cast<BlockType>(type)))
+    return s + 1 < kSectionCount && snap.sectionUniform(0, s + 1) == type;
+
+  if (!isOccluder(static_cast<BlockType>(type)) || s == 0 ||
+      s + 1 >= kSectionCount)
+    return false;
+  if (!uniformOccluder(0, s - 1) || !uniformOccluder(0, s + 1)) return false;
+  for (int side = 1; side <= 4; ++side)
+    if (!uniformOccluder(side, s)) return false;
+  return true;
+}
+
 // Computes AO level for a single vertex corner.
 // side1, side2 = the two edge-adjacent blocks on the face plane
 // corner = the diagonally-adjacent block
@@ -59,18 +93,15 @@ inline int vertexAO(bool side1, bool side2, bool corner) {
 // The corner ordering must match the vertex positions emitted per face.
 using AO4 = std::array<uint8_t, 4>;
 
-AO4 computeFaceAO(World* world, const Chunk& chunk, int x, int y, int z, Face face) {
+// S(dx, dy, dz) reports whether the block at that offset from the face's own
+// block occludes; the scalar and binary meshers sample it differently.
+template <typename Solid>
+AO4 faceAO(const Solid& S, Face face) {
   // For each face, we need to sample 8 neighbors on the face's plane.
   // The face plane is offset by the face normal from (x,y,z).
   // We define two tangent axes (a, b) on the face plane.
   // Neighbors are at: (-a,-b), (0,-b), (+a,-b), (-a,0), (+a,0), (-a,+b), (0,+b), (+a,+b)
   // For each corner, we pick the 2 edges + 1 corner.
-
-  // Lambda to check solidity relative to face
-  auto S = [&](int dx, int dy, int dz) -> bool {
-    return isAOSolid(world, chunk, x + dx, y + dy, z + dz);
-  };
-
   switch (face) {
     case Face::Top: { // +Y face: plane at y+1, tangent axes = x, z
       // Neighbors in the y+1 plane
@@ -179,6 +210,12 @@ AO4 computeFaceAO(World* world, const Chunk& chunk, int x, int y, int z, Face fa
   return {{3, 3, 3, 3}}; // fallback: no occlusion
 }
 
+AO4 computeFaceAO(const ChunkSnapshot& snap, int x, int y, int z, Face face) {
+  return faceAO([&](int dx, int dy, int dz) {
+    return isAOSolid(snap, x + dx, y + dy, z + dz);
+  }, face);
+}
+
 void addQuad(MeshBuffers& buffers,
              int posX, int posY, int posZ,
              int sizeA, int sizeB,
@@ -313,135 +350,48 @@ void addQuad(MeshBuffers& buffers,
   }
 }
 
-} // namespace
-
-ChunkMesh::ChunkMesh() {
-  // GL objects created lazily in upload() on main thread
-}
-
-ChunkMesh::~ChunkMesh() {
-  if (VAO) glDeleteVertexArrays(1, &VAO);
-  if (VBO) glDeleteBuffers(1, &VBO);
-  if (EBO) glDeleteBuffers(1, &EBO);
-  if (transparentVAO) glDeleteVertexArrays(1, &transparentVAO);
-  if (transparentVBO) glDeleteBuffers(1, &transparentVBO);
-  if (transparentEBO) glDeleteBuffers(1, &transparentEBO);
-}
-
-BlockType ChunkMesh::getBlock(World *world, const Chunk &chunk, int x, int y, int z) {
-  if (y < 0 || y >= kChunkHeight) {
-    return BlockType::AIR;
-  }
-
-  const int chunk_x = chunk.getPos()[0];
-  const int chunk_z = chunk.getPos()[1];
+// ─── Scalar mesher ─────────────────────────────────────────────────────
 
-  const int world_x = chunk_x * kChunkWidth + x;
-  const int world_z = chunk_z * kChunkDepth + z;
+// Six greedy sweeps that test every voxel against its neighbour one at a time.
+void meshScalar(const ChunkSnapshot& snap, MeshBuffers& buffers,
+                int16_t chunkWorldX, int16_t chunkWorldZ) {
+  // Nothing above the chunk's highest block can produce a face.
+  const int y_end = snap.maxHeight() + 1;
 
-  const int target_chunk_x = floor((float)world_x / kChunkWidth);
-  const int target_chunk_z = floor((float)world_z / kChunkDepth);
-
-  if (target_chunk_x != chunk_x || target_chunk_z != chunk_z) {
-    auto n = world->getChunk(target_chunk_x, target_chunk_z);
-    const int local_x = world_x - target_chunk_x * kChunkWidth;
-    const int local_z = world_z - target_chunk_z * kChunkDepth;
-    return n ? n->at(local_x, y, local_z) : BlockType::AIR;
-  }
-
-  return chunk.at(x, y, z);
-}
-
-uint8_t ChunkMesh::getSkyLight(World *world, const Chunk &chunk, int x, int y, int z) {
-  // Above the chunk height = full sky
-  if (y >= kChunkHeight) return 15;
-  if (y < 0) return 0;
-
-  const int chunk_x = chunk.getPos()[0];
-  const int chunk_z = chunk.getPos()[1];
-
-  const int world_x = chunk_x * kChunkWidth + x;
-  const int world_z = chunk_z * kChunkDepth + z;
-
-  const int target_chunk_x = floor((float)world_x / kChunkWidth);
-  const int target_chunk_z = floor((float)world_z / kChunkDepth);
-
-  if (target_chunk_x != chunk_x || target_chunk_z != chunk_z) {
-    auto n = world->getChunk(target_chunk_x, target_chunk_z);
-    if (!n) return 15; // unloaded neighbor — assume full sky
-    const int local_x = world_x - target_chunk_x * kChunkWidth;
-    const int local_z = world_z - target_chunk_z * kChunkDepth;
-    return n->safeSkyLight(local_x, y, local_z);
-  }
-
-  return chunk.safeSkyLight(x, y, z);
-}
-
-uint8_t ChunkMesh::getBlockLight(World *world, const Chunk &chunk, int x, int y, int z) {
-  // Outside the vertical range there is no emitted light.
-  if (y < 0 || y >= kChunkHeight) return 0;
-
-  const int chunk_x = chunk.getPos()[0];
-  const int chunk_z = chunk.getPos()[1];
-
-  const int world_x = chunk_x * kChunkWidth + x;
-  const int world_z = chunk_z * kChunkDepth + z;
-
-  const int target_chunk_x = floor((float)world_x / kChunkWidth);
-  const int target_chunk_z = floor((float)world_z / kChunkDepth);
-
-  if (target_chunk_x != chunk_x || target_chunk_z != chunk_z) {
-    auto n = world->getChunk(target_chunk_x, target_chunk_z);
-    if (!n) return 0; // unloaded neighbor — no known light
-    const int local_x = world_x - target_chunk_x * kChunkWidth;
-    const int local_z = world_z - target_chunk_z * kChunkDepth;
-    return n->safeBlockLight(local_x, y, local_z);
-  }
-
-  return chunk.safeBlockLight(x, y, z);
-}
-
-void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
-                            TextureManager &) {
-  cpuReady = false;
-  // gpuUploaded intentionally NOT reset — old GPU buffers keep rendering
-  // while this CPU rebuild runs; upload() will overwrite them in-place.
-  vertices.clear();
-  indices.clear();
-  transparentVertices.clear();
-  transparentIndices.clear();
-
-  // Compute chunk world offset for batch rendering
-  const int16_t chunkWorldX = static_cast<int16_t>(chunk.getPos().x * kChunkWidth);
-  const int16_t chunkWorldZ = static_cast<int16_t>(chunk.getPos().y * kChunkDepth);
-
-  MeshBuffers buffers{vertices, indices, transparentVertices, transparentIndices};
+  // Sections that can't produce faces are skipped by every sweep below.
+  bool skip[kSectionCount];
+  for (int s = 0; s < kSectionCount; ++s)
+    skip[s] = canSkipSection(snap, s);
 
   // Front face (+Z)
   for (int z = 0; z < kChunkDepth; ++z) {
     bool mask[kChunkWidth][kChunkHeight] = {false};
-    for (int y = 0; y < kChunkHeight; ++y) {
+    for (int y = 0; y < y_end; ++y) {
+      if (skip[y / kSectionHeight]) {
+        y += kSectionHeight - 1;
+        continue;
+      }
       for (int x = 0; x < kChunkWidth; ++x) {
         if (mask[x][y]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
         if (isLiquid(type)) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x, y, z + 1);
+        BlockType neighbor = snap.block(x, y, z + 1);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Front);
-          uint8_t skyLight = getSkyLight(world, chunk, x, y, z + 1);
-          uint8_t blockLight = getBlockLight(world, chunk, x, y, z + 1);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Front);
+          uint8_t light = snap.light(x, y, z + 1);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int width = 1;
           while (x + width < kChunkWidth && !mask[x + width][y] &&
-                 chunk.safeAt(x + width, y, z) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x + width, y, z + 1)) &&
-                 getSkyLight(world, chunk, x + width, y, z + 1) == skyLight &&
-                 getBlockLight(world, chunk, x + width, y, z + 1) == blockLight &&
-                 computeFaceAO(world, chunk, x + width, y, z, Face::Front) == ao) {
+                 snap.block(x + width, y, z) == type &&
+                 shouldRenderFace(type, snap.block(x + width, y, z + 1)) &&
+                 snap.light(x + width, y, z + 1) == light &&
+                 computeFaceAO(snap, x + width, y, z, Face::Front) == ao) {
             width++;
           }
 
@@ -450,11 +400,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (y + height < kChunkHeight && can_expand) {
             for (int i = 0; i < width; ++i) {
               if (mask[x + i][y + height] ||
-                  chunk.safeAt(x + i, y + height, z) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x + i, y + height, z + 1)) ||
-                  getSkyLight(world, chunk, x + i, y + height, z + 1) != skyLight ||
-                  getBlockLight(world, chunk, x + i, y + height, z + 1) != blockLight ||
-                  computeFaceAO(world, chunk, x + i, y + height, z, Face::Front) != ao) {
+                  snap.block(x + i, y + height, z) != type ||
+                  !shouldRenderFace(type, snap.block(x + i, y + height, z + 1)) ||
+                  snap.light(x + i, y + height, z + 1) != light ||
+                  computeFaceAO(snap, x + i, y + height, z, Face::Front) != ao) {
                 can_expand = false;
                 break;
               }
@@ -477,28 +426,32 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
   // Back face (-Z)
   for (int z = kChunkDepth - 1; z >= 0; --z) {
     bool mask[kChunkWidth][kChunkHeight] = {false};
-    for (int y = 0; y < kChunkHeight; ++y) {
+    for (int y = 0; y < y_end; ++y) {
+      if (skip[y / kSectionHeight]) {
+        y += kSectionHeight - 1;
+        continue;
+      }
       for (int x = 0; x < kChunkWidth; ++x) {
         if (mask[x][y]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
         if (isLiquid(type)) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x, y, z - 1);
+        BlockType neighbor = snap.block(x, y, z - 1);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Back);
-          uint8_t skyLight = getSkyLight(world, chunk, x, y, z - 1);
-          uint8_t blockLight = getBlockLight(world, chunk, x, y, z - 1);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Back);
+          uint8_t light = snap.light(x, y, z - 1);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int width = 1;
           while (x + width < kChunkWidth && !mask[x + width][y] &&
-                 chunk.safeAt(x + width, y, z) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x + width, y, z - 1)) &&
-                 getSkyLight(world, chunk, x + width, y, z - 1) == skyLight &&
-                 getBlockLight(world, chunk, x + width, y, z - 1) == blockLight &&
-                 computeFaceAO(world, chunk, x + width, y, z, Face::Back) == ao) {
+                 snap.block(x + width, y, z) == type &&
+                 shouldRenderFace(type, snap.block(x + width, y, z - 1)) &&
+                 snap.light(x + width, y, z - 1) == light &&
+                 computeFaceAO(snap, x + width, y, z, Face::Back) == ao) {
             width++;
           }
 
@@ -507,11 +460,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (y + height < kChunkHeight && can_expand) {
             for (int i = 0; i < width; ++i) {
               if (mask[x + i][y + height] ||
-                  chunk.safeAt(x + i, y + height, z) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x + i, y + height, z - 1)) ||
-                  getSkyLight(world, chunk, x + i, y + height, z - 1) != skyLight ||
-                  getBlockLight(world, chunk, x + i, y + height, z - 1) != blockLight ||
-                  computeFaceAO(world, chunk, x + i, y + height, z, Face::Back) != ao) {
+                  snap.block(x + i, y + height, z) != type ||
+                  !shouldRenderFace(type, snap.block(x + i, y + height, z - 1)) ||
+                  snap.light(x + i, y + height, z - 1) != light ||
+                  computeFaceAO(snap, x + i, y + height, z, Face::Back) != ao) {
                 can_expand = false;
                 break;
               }
@@ -532,29 +484,33 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
   }
 
   // Top face (+Y)
-  for (int y = 0; y < kChunkHeight; ++y) {
+  for (int y = 0; y < y_end; ++y) {
+    if (skip[y / kSectionHeight]) {
+      y += kSectionHeight - 1;
+      continue;
+    }
     bool mask[kChunkDepth][kChunkWidth] = {false};
     for (int z = 0; z < kChunkDepth; ++z) {
       for (int x = 0; x < kChunkWidth; ++x) {
         if (mask[z][x]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x, y + 1, z);
+        BlockType neighbor = snap.block(x, y + 1, z);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Top);
-          uint8_t skyLight = getSkyLight(world, chunk, x, y + 1, z);
-          uint8_t blockLight = getBlockLight(world, chunk, x, y + 1, z);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Top);
+          uint8_t light = snap.light(x, y + 1, z);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int width = 1;
           while (x + width < kChunkWidth && !mask[z][x + width] &&
-                 chunk.safeAt(x + width, y, z) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x + width, y + 1, z)) &&
-                 getSkyLight(world, chunk, x + width, y + 1, z) == skyLight &&
-                 getBlockLight(world, chunk, x + width, y + 1, z) == blockLight &&
-                 computeFaceAO(world, chunk, x + width, y, z, Face::Top) == ao) {
+                 snap.block(x + width, y, z) == type &&
+                 shouldRenderFace(type, snap.block(x + width, y + 1, z)) &&
+                 snap.light(x + width, y + 1, z) == light &&
+                 computeFaceAO(snap, x + width, y, z, Face::Top) == ao) {
             width++;
           }
 
@@ -563,11 +519,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (z + depth < kChunkDepth && can_expand) {
             for (int i = 0; i < width; ++i) {
               if (mask[z + depth][x + i] ||
-                  chunk.safeAt(x + i, y, z + depth) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x + i, y + 1, z + depth)) ||
-                  getSkyLight(world, chunk, x + i, y + 1, z + depth) != skyLight ||
-                  getBlockLight(world, chunk, x + i, y + 1, z + depth) != blockLight ||
-                  computeFaceAO(world, chunk, x + i, y, z + depth, Face::Top) != ao) {
+                  snap.block(x + i, y, z + depth) != type ||
+                  !shouldRenderFace(type, snap.block(x + i, y + 1, z + depth)) ||
+                  snap.light(x + i, y + 1, z + depth) != light ||
+                  computeFaceAO(snap, x + i, y, z + depth, Face::Top) != ao) {
                 can_expand = false;
                 break;
               }
@@ -597,30 +552,34 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
   }
 
   // Bottom face (-Y)
-  for (int y = kChunkHeight - 1; y >= 0; --y) {
+  for (int y = y_end - 1; y >= 0; --y) {
+    if (skip[y / kSectionHeight]) {
+      y = (y / kSectionHeight) * kSectionHeight; // jump to the section floor
+      continue;
+    }
     bool mask[kChunkDepth][kChunkWidth] = {false};
     for (int z = 0; z < kChunkDepth; ++z) {
       for (int x = 0; x < kChunkWidth; ++x) {
         if (mask[z][x]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
         if (isLiquid(type)) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x, y - 1, z);
+        BlockType neighbor = snap.block(x, y - 1, z);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Bottom);
-          uint8_t skyLight = getSkyLight(world, chunk, x, y - 1, z);
-          uint8_t blockLight = getBlockLight(world, chunk, x, y - 1, z);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Bottom);
+          uint8_t light = snap.light(x, y - 1, z);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int width = 1;
           while (x + width < kChunkWidth && !mask[z][x + width] &&
-                 chunk.safeAt(x + width, y, z) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x + width, y - 1, z)) &&
-                 getSkyLight(world, chunk, x + width, y - 1, z) == skyLight &&
-                 getBlockLight(world, chunk, x + width, y - 1, z) == blockLight &&
-                 computeFaceAO(world, chunk, x + width, y, z, Face::Bottom) == ao) {
+                 snap.block(x + width, y, z) == type &&
+                 shouldRenderFace(type, snap.block(x + width, y - 1, z)) &&
+                 snap.light(x + width, y - 1, z) == light &&
+                 computeFaceAO(snap, x + width, y, z, Face::Bottom) == ao) {
             width++;
           }
 
@@ -629,11 +588,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (z + depth < kChunkDepth && can_expand) {
             for (int i = 0; i < width; ++i) {
               if (mask[z + depth][x + i] ||
-                  chunk.safeAt(x + i, y, z + depth) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x + i, y - 1, z + depth)) ||
-                  getSkyLight(world, chunk, x + i, y - 1, z + depth) != skyLight ||
-                  getBlockLight(world, chunk, x + i, y - 1, z + depth) != blockLight ||
-                  computeFaceAO(world, chunk, x + i, y, z + depth, Face::Bottom) != ao) {
+                  snap.block(x + i, y, z + depth) != type ||
+                  !shouldRenderFace(type, snap.block(x + i, y - 1, z + depth)) ||
+                  snap.light(x + i, y - 1, z + depth) != light ||
+                  computeFaceAO(snap, x + i, y, z + depth, Face::Bottom) != ao) {
                 can_expand = false;
                 break;
               }
@@ -656,28 +614,32 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
   // Right face (+X)
   for (int x = 0; x < kChunkWidth; ++x) {
     bool mask[kChunkHeight][kChunkDepth] = {false};
-    for (int y = 0; y < kChunkHeight; ++y) {
+    for (int y = 0; y < y_end; ++y) {
+      if (skip[y / kSectionHeight]) {
+        y += kSectionHeight - 1;
+        continue;
+      }
       for (int z = 0; z < kChunkDepth; ++z) {
         if (mask[y][z]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
         if (isLiquid(type)) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x + 1, y, z);
+        BlockType neighbor = snap.block(x + 1, y, z);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Right);
-          uint8_t skyLight = getSkyLight(world, chunk, x + 1, y, z);
-          uint8_t blockLight = getBlockLight(world, chunk, x + 1, y, z);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Right);
+          uint8_t light = snap.light(x + 1, y, z);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int depth = 1;
           while (z + depth < kChunkDepth && !mask[y][z + depth] &&
-                 chunk.safeAt(x, y, z + depth) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x + 1, y, z + depth)) &&
-                 getSkyLight(world, chunk, x + 1, y, z + depth) == skyLight &&
-                 getBlockLight(world, chunk, x + 1, y, z + depth) == blockLight &&
-                 computeFaceAO(world, chunk, x, y, z + depth, Face::Right) == ao) {
+                 snap.block(x, y, z + depth) == type &&
+                 shouldRenderFace(type, snap.block(x + 1, y, z + depth)) &&
+                 snap.light(x + 1, y, z + depth) == light &&
+                 computeFaceAO(snap, x, y, z + depth, Face::Right) == ao) {
             depth++;
           }
 
@@ -686,11 +648,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (y + height < kChunkHeight && can_expand) {
             for (int i = 0; i < depth; ++i) {
               if (mask[y + height][z + i] ||
-                  chunk.safeAt(x, y + height, z + i) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x + 1, y + height, z + i)) ||
-                  getSkyLight(world, chunk, x + 1, y + height, z + i) != skyLight ||
-                  getBlockLight(world, chunk, x + 1, y + height, z + i) != blockLight ||
-                  computeFaceAO(world, chunk, x, y + height, z + i, Face::Right) != ao) {
+                  snap.block(x, y + height, z + i) != type ||
+                  !shouldRenderFace(type, snap.block(x + 1, y + height, z + i)) ||
+                  snap.light(x + 1, y + height, z + i) != light ||
+                  computeFaceAO(snap, x, y + height, z + i, Face::Right) != ao) {
                 can_expand = false;
                 break;
               }
@@ -713,28 +674,32 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
   // Left face (-X)
   for (int x = kChunkWidth - 1; x >= 0; --x) {
     bool mask[kChunkHeight][kChunkDepth] = {false};
-    for (int y = 0; y < kChunkHeight; ++y) {
+    for (int y = 0; y < y_end; ++y) {
+      if (skip[y / kSectionHeight]) {
+        y += kSectionHeight - 1;
+        continue;
+      }
       for (int z = 0; z < kChunkDepth; ++z) {
         if (mask[y][z]) continue;
 
-        BlockType type = chunk.at(x, y, z);
+        BlockType type = snap.block(x, y, z);
         if (type == BlockType::AIR) continue;
         if (isLiquid(type)) continue;
 
-        BlockType neighbor = getBlock(world, chunk, x - 1, y, z);
+        BlockType neighbor = snap.block(x - 1, y, z);
         if (shouldRenderFace(type, neighbor)) {
           const auto &tex = block_data.at(type);
-          AO4 ao = computeFaceAO(world, chunk, x, y, z, Face::Left);
-          uint8_t skyLight = getSkyLight(world, chunk, x - 1, y, z);
-          uint8_t blockLight = getBlockLight(world, chunk, x - 1, y, z);
+          AO4 ao = computeFaceAO(snap, x, y, z, Face::Left);
+          uint8_t light = snap.light(x - 1, y, z);
+          uint8_t skyLight = skyLightOf(light);
+          uint8_t blockLight = blockLightOf(light);
 
           int depth = 1;
           while (z + depth < kChunkDepth && !mask[y][z + depth] &&
-                 chunk.safeAt(x, y, z + depth) == type &&
-                 shouldRenderFace(type, getBlock(world, chunk, x - 1, y, z + depth)) &&
-                 getSkyLight(world, chunk, x - 1, y, z + depth) == skyLight &&
-                 getBlockLight(world, chunk, x - 1, y, z + depth) == blockLight &&
-                 computeFaceAO(world, chunk, x, y, z + depth, Face::Left) == ao) {
+                 snap.block(x, y, z + depth) == type &&
+                 shouldRenderFace(type, snap.block(x - 1, y, z + depth)) &&
+                 snap.light(x - 1, y, z + depth) == light &&
+                 computeFaceAO(snap, x, y, z + depth, Face::Left) == ao) {
             depth++;
           }
 
@@ -743,11 +708,10 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
           while (y + height < kChunkHeight && can_expand) {
             for (int i = 0; i < depth; ++i) {
               if (mask[y + height][z + i] ||
-                  chunk.safeAt(x, y + height, z + i) != type ||
-                  !shouldRenderFace(type, getBlock(world, chunk, x - 1, y + height, z + i)) ||
-                  getSkyLight(world, chunk, x - 1, y + height, z + i) != skyLight ||
-                  getBlockLight(world, chunk, x - 1, y + height, z + i) != blockLight ||
-                  computeFaceAO(world, chunk, x, y + height, z + i, Face::Left) != ao) {
+                  snap.block(x, y + height, z + i) != type ||
+                  !shouldRenderFace(type, snap.block(x - 1, y + height, z + i)) ||
+                  snap.light(x - 1, y + height, z + i) != light ||
+                  computeFaceAO(snap, x, y + height, z + i, Face::Left) != ao) {
                 can_expand = false;
                 break;
               }
@@ -766,6 +730,271 @@ void ChunkMesh::generateCPU(World *world, const Chunk &chunk,
       }
     }
   }
+}
+
+// ─── Binary mesher ─────────────────────────────────────────────────────
+// Classifies every voxel once into bit rows, derives each face's visibility
+// for 16 voxels at a time with shifts and ANDs, then walks the visible bits
+// with ctz using the scalar mesher's greedy rules. AO comes from the occluder
+// rows. Transparent and liquid blocks keep the per-voxel shouldRenderFace
+// test; outside of water surfaces there are very few of them.
+
+enum : uint8_t {
+  kSeeThrough = 1 << 0, // an opaque face against it is visible
+  kOccludes   = 1 << 1, // counts for AO
+  kOpaqueRule = 1 << 2, // emits faces wherever the neighbour is see-through
+  kPerVoxel   = 1 << 3, // transparent / liquid: tested one voxel at a time
+};
+
+std::array<uint8_t, 256> makeClassTable() {
+  std::array<uint8_t, 256> table{};
+  for (int i = 0; i < 256; ++i) {
+    const BlockType b = static_cast<BlockType>(i);
+    uint8_t c = 0;
+    if (b == BlockType::AIR || isCutout(b) || isTransparent(b)) c |= kSeeThrough;
+    if (isOccluder(b)) c |= kOccludes;
+    if (b != BlockType::AIR)
+      c |= (isTransparent(b) || isLiquid(b)) ? kPerVoxel : kOpaqueRule;
+    table[i] = c;
+  }
+  return table;
+}
+
+constexpr int kPadRows = kChunkHeight + 2; // y = -1 .. 256
+
+struct BinaryMasks {
+  // Padded rows: bit x+1 (or z+1) for x (or z) in -1..16.
+  uint32_t see_x[kPadRows][ChunkSnapshot::kSizeZ];
+  uint32_t see_z[kPadRows][ChunkSnapshot::kSizeX];
+  uint32_t occ_x[kPadRows][ChunkSnapshot::kSizeZ];
+  // In-chunk kOpaqueRule voxels, bit x (or z).
+  uint16_t opaque_x[kChunkHeight][kChunkDepth];
+  uint16_t opaque_z[kChunkHeight][kChunkWidth];
+  // Visible faces as [slice][row]: ±Z by z with rows y and bits x, ±Y by y
+  // with rows z and bits x, ±X by x with rows y and bits z.
+  uint16_t front[kChunkDepth][kChunkHeight], back[kChunkDepth][kChunkHeight];
+  uint16_t top[kChunkHeight][kChunkDepth], bottom[kChunkHeight][kChunkDepth];
+  uint16_t right[kChunkWidth][kChunkHeight], left[kChunkWidth][kChunkHeight];
+  std::vector<glm::ivec3> per_voxel;
+};
+
+// Face normals, indexed by Face.
+constexpr int kNormalX[6] = {0, 0, -1, 1, 0, 0};
+constexpr int kNormalY[6] = {1, -1, 0, 0, 0, 0};
+constexpr int kNormalZ[6] = {0, 0, 0, 0, 1, -1};
+
+void buildMasks(const ChunkSnapshot& snap, int y_end, BinaryMasks& m) {
+  static const std::array<uint8_t, 256> kClass = makeClassTable();
+  m.per_voxel.clear();
+
+  for (int y = -1; y <= y_end; ++y) {
+    uint32_t* see_z = m.see_z[y + 1];
+    std::fill(see_z, see_z + ChunkSnapshot::kSizeX, 0u);
+    const bool inside_y = y >= 0 && y < y_end;
+    if (inside_y) std::fill(m.opaque_z[y], m.opaque_z[y] + kChunkWidth, uint16_t{0});
+
+    for (int z = -1; z <= kChunkDepth; ++z) {
+      uint32_t see = 0, occ = 0, opaque = 0, per_voxel = 0;
+      for (int x = -1; x <= kChunkWidth; ++x) {
+        const uint32_t c = kClass[static_cast<uint8_t>(snap.block(x, y, z))];
+        see       |= (c & 1u) << (x + 1);
+        occ       |= ((c >> 1) & 1u) << (x + 1);
+        opaque    |= ((c >> 2) & 1u) << (x + 1);
+        per_voxel |= ((c >> 3) & 1u) << (x + 1);
+        see_z[x + 1] |= (c & 1u) << (z + 1);
+      }
+      m.see_x[y + 1][z + 1] = see;
+      m.occ_x[y + 1][z + 1] = occ;
+
+      if (!inside_y || z < 0 || z >= kChunkDepth) continue;
+      const uint16_t row = static_cast<uint16_t>(opaque >> 1);
+      m.opaque_x[y][z] = row;
+      for (uint32_t bits = row; bits; bits &= bits - 1)
+        m.opaque_z[y][std::countr_zero(bits)] |= static_cast<uint16_t>(1u << z);
+      for (uint32_t bits = (per_voxel >> 1) & 0xFFFFu; bits; bits &= bits - 1)
+        m.per_voxel.push_back({std::countr_zero(bits), y, z});
+    }
+  }
+
+  // An opaque-rule face is visible where the neighbour row is see-through.
+  for (int y = 0; y < y_end; ++y) {
+    for (int z = 0; z < kChunkDepth; ++z) {
+      const uint16_t op = m.opaque_x[y][z];
+      m.front[z][y]  = op & static_cast<uint16_t>(m.see_x[y + 1][z + 2] >> 1);
+      m.back[z][y]   = op & static_cast<uint16_t>(m.see_x[y + 1][z] >> 1);
+      m.top[y][z]    = op & static_cast<uint16_t>(m.see_x[y + 2][z + 1] >> 1);
+      m.bottom[y][z] = op & static_cast<uint16_t>(m.see_x[y][z + 1] >> 1);
+    }
+    for (int x = 0; x < kChunkWidth; ++x) {
+      const uint16_t op = m.opaque_z[y][x];
+      m.right[x][y] = op & static_cast<uint16_t>(m.see_z[y + 1][x + 2] >> 1);
+      m.left[x][y]  = op & static_cast<uint16_t>(m.see_z[y + 1][x] >> 1);
+    }
+  }
+
+  // Liquids only ever show their top face.
+  for (const glm::ivec3& v : m.per_voxel) {
+    const BlockType type = snap.block(v.x, v.y, v.z);
+    auto visible = [&](int dx, int dy, int dz) {
+      return shouldRenderFace(type, snap.block(v.x + dx, v.y + dy, v.z + dz));
+    };
+    const uint16_t bit_x = static_cast<uint16_t>(1u << v.x);
+    if (visible(0, 1, 0)) m.top[v.y][v.z] |= bit_x;
+    if (isLiquid(type)) continue;
+    const uint16_t bit_z = static_cast<uint16_t>(1u << v.z);
+    if (visible(0, -1, 0)) m.bottom[v.y][v.z] |= bit_x;
+    if (visible(0, 0, 1))  m.front[v.z][v.y] |= bit_x;
+    if (visible(0, 0, -1)) m.back[v.z][v.y] |= bit_x;
+    if (visible(1, 0, 0))  m.right[v.x][v.y] |= bit_z;
+    if (visible(-1, 0, 0)) m.left[v.x][v.y] |= bit_z;
+  }
+}
+
+AO4 maskFaceAO(const BinaryMasks& m, const glm::ivec3& v, Face face) {
+  return faceAO([&](int dx, int dy, int dz) -> bool {
+    return (m.occ_x[v.y + dy + 1][v.z + dz + 1] >> (v.x + dx + 1)) & 1u;
+  }, face);
+}
+
+// Greedy-merges one slice of visible bits. `open` holds the slice's rows and
+// is consumed; voxel(row, bit) maps a bit back to chunk-local coordinates.
+template <typename Voxel>
+void greedySlice(uint16_t* open, int rows, Face face, const Voxel& voxel,
+                 const ChunkSnapshot& snap, const BinaryMasks& m,
+                 MeshBuffers& buffers, int16_t chunkWorldX, int16_t chunkWorldZ) {
+  const int nx = kNormalX[face], ny = kNormalY[face], nz = kNormalZ[face];
+
+  for (int r = 0; r < rows; ++r) {
+    while (open[r]) {
+      const int b = std::countr_zero(open[r]);
+      const glm::ivec3 v = voxel(r, b);
+      const BlockType type = snap.block(v.x, v.y, v.z);
+      const uint8_t light = snap.light(v.x + nx, v.y + ny, v.z + nz);
+      const AO4 ao = maskFaceAO(m, v, face);
+
+      auto matches = [&](int row, int bit) {
+        const glm::ivec3 w = voxel(row, bit);
+        return snap.block(w.x, w.y, w.z) == type &&
+               snap.light(w.x + nx, w.y + ny, w.z + nz) == light &&
+               maskFaceAO(m, w, face) == ao;
+      };
+
+      int width = 1;
+      while (b + width < 16 && ((open[r] >> (b + width)) & 1u) &&
+             matches(r, b + width))
+        width++;
+      const uint16_t run = static_cast<uint16_t>(((1u << width) - 1) << b);
+
+      int height = 1;
+      while (r + height < rows && (open[r + height] & run) == run) {
+        bool can_expand = true;
+        for (int i = 0; i < width && can_expand; ++i)
+          can_expand = matches(r + height, b + i);
+        if (!can_expand) break;
+        height++;
+      }
+
+      for (int i = 0; i < height; ++i)
+        open[r + i] &= static_cast<uint16_t>(~run);
+
+      const auto &tex = block_data.at(type);
+      const glm::ivec2 tile = face == Face::Top    ? tex.top
+                            : face == Face::Bottom ? tex.bottom
+                                                   : tex.side;
+      addQuad(buffers, v.x, v.y, v.z, width, height,
+              tile.x, tile.y, face, chunkWorldX, chunkWorldZ,
+              isTransparent(type), cutoutClass(type), ao,
+              skyLightOf(light), blockLightOf(light));
+
+      // Surface water also gets an underside, as in the scalar mesher.
+      if (face == Face::Top && isLiquid(type) &&
+          snap.block(v.x, v.y + 1, v.z) == BlockType::AIR) {
+        AO4 noAO = {{3, 3, 3, 3}};
+        addQuad(buffers, v.x, v.y + 1, v.z, width, height,
+                tex.bottom.x, tex.bottom.y, Face::Bottom, chunkWorldX, chunkWorldZ,
+                true, kCutoutNone, noAO, skyLightOf(light), blockLightOf(light));
+      }
+    }
+  }
+}
+
+void meshBinary(const ChunkSnapshot& snap, MeshBuffers& buffers,
+                int16_t chunkWorldX, int16_t chunkWorldZ) {
+  const int y_end = snap.maxHeight() + 1;
+  if (y_end <= 0) return;
+
+  thread_local BinaryMasks m; // ~120 KB, reused by each worker
+  buildMasks(snap, y_end, m);
+
+  auto sweep = [&](uint16_t* rows, int count, Face face, const auto& voxel) {
+    greedySlice(rows, count, face, voxel, snap, m, buffers,
+                chunkWorldX, chunkWorldZ);
+  };
+
+  // Same sweep order as meshScalar so both emit identical buffers.
+  for (int z = 0; z < kChunkDepth; ++z)
+    sweep(m.front[z], y_end, Face::Front,
+          [z](int r, int b) { return glm::ivec3(b, r, z); });
+  for (int z = kChunkDepth - 1; z >= 0; --z)
+    sweep(m.back[z], y_end, Face::Back,
+          [z](int r, int b) { return glm::ivec3(b, r, z); });
+  for (int y = 0; y < y_end; ++y)
+    sweep(m.top[y], kChunkDepth, Face::Top,
+          [y](int r, int b) { return glm::ivec3(b, y, r); });
+  for (int y = y_end - 1; y >= 0; --y)
+    sweep(m.bottom[y], kChunkDepth, Face::Bottom,
+          [y](int r, int b) { return glm::ivec3(b, y, r); });
+  for (int x = 0; x < kChunkWidth; ++x)
+    sweep(m.right[x], y_end, Face::Right,
+          [x](int r, int b) { return glm::ivec3(x, r, b); });
+  for (int x = kChunkWidth - 1; x >= 0; --x)
+    sweep(m.left[x], y_end, Face::Left,
+          [x](int r, int b) { return glm::ivec3(x, r, b); });
+}
+
+} // namespace
+
+ChunkMesh::ChunkMesh() {
+  // GL objects created lazily in upload() on main thread
+}
+
+ChunkMesh::~ChunkMesh() {
+  release();
+}
+
+void ChunkMesh::release() {
+  if (VAO) glDeleteVertexArrays(1, &VAO);
+  if (VBO) glDeleteBuffers(1, &VBO);
+  if (EBO) glDeleteBuffers(1, &EBO);
+  if (transparentVAO) glDeleteVertexArrays(1, &transparentVAO);
+  if (transparentVBO) glDeleteBuffers(1, &transparentVBO);
+  if (transparentEBO) glDeleteBuffers(1, &transparentEBO);
+  VAO = VBO = EBO = 0;
+  transparentVAO = transparentVBO = transparentEBO = 0;
+  opaque_index_count = transparent_index_count = 0;
+  gpuUploaded = false;
+}
+
+void ChunkMesh::generateCPU(const ChunkSnapshot &snap, TextureManager &) {
+  cpuReady = false;
+  // gpuUploaded intentionally NOT reset — old GPU buffers keep rendering
+  // while this CPU rebuild runs; upload() will overwrite them in-place.
+  vertices.clear();
+  indices.clear();
+  transparentVertices.clear();
+  transparentIndices.clear();
+
+  // Compute chunk world offset for batch rendering
+  const int16_t chunkWorldX = static_cast<int16_t>(snap.getPos().x * kChunkWidth);
+  const int16_t chunkWorldZ = static_cast<int16_t>(snap.getPos().y * kChunkDepth);
+
+  MeshBuffers buffers{vertices, indices, transparentVertices, transparentIndices};
+
+  // Both meshers emit identical quads in identical order.
+  if (g_settings.binary_mesher)
+    meshBinary(snap, buffers, chunkWorldX, chunkWorldZ);
+  else
+    meshScalar(snap, buffers, chunkWorldX, chunkWorldZ);
 
   cpuReady = !vertices.empty() || !transparentVertices.empty();
 }
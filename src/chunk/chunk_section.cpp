@@ -0,0 +1,174 @@
+#include "chunk/chunk_section.hpp"
+#include <array>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kWordCount(uint8_t bits) {
+  return static_cast<uint32_t>(kSectionVolume) * bits / 64;
+}
+
+// Unpacks every index of a `Bits`-wide packed array through the palette.
+// Entries never straddle a word since Bits divides 64.
+template <int Bits>
+void unpack(const std::vector<uint64_t> &words,
+            const std::vector<BlockType> &palette, BlockType *out) {
+  constexpr int kPerWord = 64 / Bits;
+  constexpr uint64_t kMask = (uint64_t{1} << Bits) - 1;
+  for (size_t w = 0; w < words.size(); ++w) {
+    uint64_t v = words[w];
+    for (int k = 0; k < kPerWord; ++k, v >>= Bits)
+      *out++ = palette[v & kMask];
+  }
+}
+
+} // namespace
+
+int ChunkSection::paletteIndex(BlockType type) const {
+  for (size_t p = 0; p < palette.size(); ++p)
+    if (palette[p] == type) return static_cast<int>(p);
+  return -1;
+}
+
+void ChunkSection::write(uint32_t i, uint32_t p) {
+  const uint32_t bit = i * bits;
+  uint64_t &w = words[bit >> 6];
+  const uint32_t shift = bit & 63;
+  w = (w & ~(mask() << shift)) | (static_cast<uint64_t>(p) << shift);
+}
+
+void ChunkSection::repack(uint8_t new_bits) {
+  std::vector<uint64_t> old;
+  old.swap(words);
+  const uint8_t old_bits = bits;
+  const uint64_t old_mask = mask();
+
+  bits = new_bits;
+  words.assign(kWordCount(bits), 0);
+  for (uint32_t i = 0; i < kSectionVolume; ++i) {
+    const uint32_t bit = i * old_bits;
+    write(i, static_cast<uint32_t>((old[bit >> 6] >> (bit & 63)) & old_mask));
+  }
+}
+
+bool ChunkSection::holdsOnly(BlockType type, uint32_t p) const {
+  if (mode == Mode::Flat) {
+    for (BlockType b : flat)
+      if (b != type) return false;
+    return true;
+  }
+  // `p` in every slot of a word: ~0 / mask has a 1 at the bottom of each.
+  const uint64_t pattern = p * (~uint64_t{0} / mask());
+  for (uint64_t w : words)
+    if (w != pattern) return false;
+  return true;
+}
+
+void ChunkSection::collapse(BlockType type) {
+  uniform = type;
+  mode = Mode::Uniform;
+  bits = 0;
+  std::vector<BlockType>().swap(flat);
+  std::vector<BlockType>().swap(palette);
+  std::vector<uint64_t>().swap(words);
+}
+
+void ChunkSection::set(uint32_t i, BlockType type) {
+  if (mode == Mode::Uniform) {
+    if (type == uniform) return;
+    if (pack_edits) {
+      palette.assign({uniform, type});
+      bits = 1;
+      words.assign(kWordCount(bits), 0);
+      mode = Mode::Packed;
+      write(i, 1);
+    } else {
+      flat.assign(kSectionVolume, uniform);
+      mode = Mode::Flat;
+      flat[i] = type;
+    }
+    return;
+  }
+
+  if (mode == Mode::Flat) {
+    flat[i] = type;
+    // Generation fills flat sections block by block; only scan once edits
+    // can empty a compacted one.
+    if (compacted && holdsOnly(type, 0)) collapse(type);
+    return;
+  }
+
+  int p = paletteIndex(type);
+  if (p < 0) {
+    // Palette full at this width: double the index width (at most 8 bits,
+    // which covers every BlockType).
+    if (palette.size() == (size_t{1} << bits))
+      repack(static_cast<uint8_t>(bits * 2));
+    palette.push_back(type);
+    p = static_cast<int>(palette.size()) - 1;
+  }
+  write(i, static_cast<uint32_t>(p));
+  if (holdsOnly(type, static_cast<uint32_t>(p))) collapse(type);
+}
+
+void ChunkSection::compact(bool pack) {
+  pack_edits = pack;
+  compacted = true;
+  if (mode != Mode::Flat) return;
+
+  std::array<int16_t, 256> lut;
+  lut.fill(-1);
+  palette.clear();
+  for (BlockType b : flat) {
+    auto &slot = lut[static_cast<uint8_t>(b)];
+    if (slot < 0) {
+      slot = static_cast<int16_t>(palette.size());
+      palette.push_back(b);
+    }
+  }
+
+  if (palette.size() == 1) {
+    uniform = palette[0];
+    mode = Mode::Uniform;
+    std::vector<BlockType>().swap(palette);
+    std::vector<BlockType>().swap(flat);
+    return;
+  }
+  if (!pack) {
+    std::vector<BlockType>().swap(palette);
+    return;
+  }
+
+  bits = 1;
+  while ((size_t{1} << bits) < palette.size()) bits *= 2;
+
+  mode = Mode::Packed;
+  words.assign(kWordCount(bits), 0);
+  for (uint32_t i = 0; i < kSectionVolume; ++i)
+    write(i, static_cast<uint32_t>(lut[static_cast<uint8_t>(flat[i])]));
+
+  std::vector<BlockType>().swap(flat); // release the flat array
+}
+
+void ChunkSection::decode(BlockType *out) const {
+  if (mode == Mode::Uniform) {
+    std::memset(out, static_cast<int>(uniform), kSectionVolume * sizeof(BlockType));
+    return;
+  }
+  if (mode == Mode::Flat) {
+    std::memcpy(out, flat.data(), kSectionVolume * sizeof(BlockType));
+    return;
+  }
+  switch (bits) {
+  case 1: unpack<1>(words, palette, out); break;
+  case 2: unpack<2>(words, palette, out); break;
+  case 4: unpack<4>(words, palette, out); break;
+  default: unpack<8>(words, palette, out); break;
+  }
+}
+
+size_t ChunkSection::memoryUsage() const {
+  return sizeof(*this) + flat.capacity() * sizeof(BlockType) +
+         palette.capacity() * sizeof(BlockType) +
+         words.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,82 @@
+#include "chunk/chunk_snapshot.hpp"
+#include "chunk/chunk.hpp"
+#include "world/world.hpp"
+#include <algorithm>
+#include <cstring>
+
+ChunkSnapshot::ChunkSnapshot()
+    : blocks(kVolume, BlockType::AIR), lights(kVolume, 0) {}
+
+void ChunkSnapshot::capture(World *world, Chunk &chunk) {
+  pos = chunk.getPos();
+
+  // Start from "nothing loaded": air under full sky, dark below the world.
+  std::fill(blocks.begin(), blocks.end(), BlockType::AIR);
+  std::fill(lights.begin(), lights.end(), packLight(15, 0));
+  std::fill(lights.begin(), lights.begin() + kSizeX * kSizeZ, 0);
+  for (auto &side : uniform) side.fill(static_cast<int16_t>(BlockType::AIR));
+
+  auto recordSections = [&](int side, const Chunk &c) {
+    for (int s = 0; s < kSectionCount; ++s) {
+      const ChunkSection &section = c.getSection(s);
+      uniform[side][s] = section.isUniform()
+                             ? static_cast<int16_t>(section.uniformType())
+                             : int16_t{-1};
+    }
+  };
+
+  // The chunk itself: decode section by section straight into padded rows.
+  {
+    ReadLock lock(chunk.data_mutex);
+    const uint8_t *src_light = chunk.lightData();
+    BlockType section_blocks[kSectionVolume];
+    for (int s = 0; s < kSectionCount; ++s) {
+      chunk.getSection(s).decode(section_blocks);
+      for (int ly = 0; ly < kSectionHeight; ++ly) {
+        const int y = s * kSectionHeight + ly;
+        for (int z = 0; z < kChunkDepth; ++z) {
+          const int src = kChunkWidth * (z + kChunkDepth * ly);
+          const int dst = index(0, y, z);
+          std::memcpy(&blocks[dst], &section_blocks[src], kChunkWidth);
+          std::memcpy(&lights[dst],
+                      &src_light[src + s * kSectionVolume], kChunkWidth);
+        }
+      }
+    }
+    max_height = chunk.maxHeight();
+    recordSections(0, chunk);
+  }
+
+  // Border voxels from the 8 neighbours. Side chunks contribute a 1x256x16
+  // strip, corner chunks a single column. Borrowed from the chunk map.
+  const ChunkMap &map = world->getChunkMap();
+  ChunkMap::ReadGuard guard(map);
+  for (int dz = -1; dz <= 1; ++dz) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      if (dx == 0 && dz == 0) continue;
+      Chunk *n = map.find({pos.x + dx, pos.y + dz});
+      if (!n) continue;
+
+      const int x0 = dx < 0 ? kChunkWidth - 1 : 0;
+      const int x1 = dx == 0 ? kChunkWidth - 1 : x0;
+      const int z0 = dz < 0 ? kChunkDepth - 1 : 0;
+      const int z1 = dz == 0 ? kChunkDepth - 1 : z0;
+      const int ox = dx * kChunkWidth; // neighbour-local -> our local
+      const int oz = dz * kChunkDepth;
+
+      ReadLock lock(n->data_mutex);
+      for (int y = 0; y < kChunkHeight; ++y)
+        for (int z = z0; z <= z1; ++z)
+          for (int x = x0; x <= x1; ++x) {
+            const int i = index(x + ox, y, z + oz);
+            blocks[i] = n->at(x, y, z);
+            lights[i] = n->getLight(x, y, z);
+          }
+
+      if (dx == 0 || dz == 0) {
+        const int side = dx < 0 ? 1 : dx > 0 ? 2 : dz < 0 ? 3 : 4;
+        recordSections(side, *n);
+      }
+    }
+  }
+}
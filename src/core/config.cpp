@@ -86,6 +86,19 @@ std::string serializeSettings(const Settings &s, bool blank_seed) {
   o << "\n"
     << "# How far (in blocks) chunks stay loaded around the player.\n"
     << "view-distance=" << s.render_distance << "\n"
+    << "# Store chunk blocks as per-section palettes (several times less\n"
+    << "# memory; false keeps one byte per block).\n"
+    << "palette-storage=" << (s.palette_storage ? "true" : "false") << "\n"
+    << "# Build chunk meshes with the bitmask mesher (false = scalar sweeps;\n"
+    << "# both produce the same meshes).\n"
+    << "binary-mesher=" << (s.binary_mesher ? "true" : "false") << "\n"
+    << "# Keep generated chunks on disk so revisited terrain loads instead of\n"
+    << "# regenerating, up to chunk-cache-mb megabytes per world.\n"
+    << "chunk-cache=" << (s.chunk_cache ? "true" : "false") << "\n"
+    << "chunk-cache-mb=" << s.chunk_cache_mb << "\n"
+    << "# Memory (MB) for the blocks of recently unloaded chunks, so walking\n"
+    << "# back into them skips generation. 0 disables it.\n"
+    << "unloaded-cache-mb=" << s.unloaded_cache_mb << "\n"
     << "\n"
     << "# ─── Window ──────────────────────────────────────────────\n"
     << "fullscreen=" << (s.fullscreen ? "true" : "false") << "\n"
@@ -179,6 +192,11 @@ void loadServerProperties(const std::string &path) {
   for (const auto &[k, v] : kv) {
     if      (k == "world-name")        { if (!v.empty()) g_settings.world_name = v; }
     else if (k == "view-distance")     applyInt(k, v, g_settings.render_distance);
+    else if (k == "palette-storage")   applyBool(k, v, g_settings.palette_storage);
+    else if (k == "binary-mesher")     applyBool(k, v, g_settings.binary_mesher);
+    else if (k == "chunk-cache")       applyBool(k, v, g_settings.chunk_cache);
+    else if (k == "chunk-cache-mb")    applyInt(k, v, g_settings.chunk_cache_mb);
+    else if (k == "unloaded-cache-mb") applyInt(k, v, g_settings.unloaded_cache_mb);
     else if (k == "fullscreen")        applyBool(k, v, g_settings.fullscreen);
     else if (k == "vsync")             applyBool(k, v, g_settings.vsync);
     else if (k == "window-width")      applyInt(k, v, g_settings.window_width);
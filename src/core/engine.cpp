@@ -9,19 +9,19 @@
 #include "imgui/backends/imgui_impl_opengl3.h"
 #include "imgui/imgui.h"
 #include "util/memory.hpp"
+#include "util/noise_batch.hpp"
 #include <GLFW/glfw3.h>
 #include <glm/ext/scalar_constants.hpp>
 #include <glm/ext/vector_float3.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <cstdio>
-#include <cstdlib>
 #include <iostream>
 
 Engine::~Engine() { cleanup(); }
 
 bool Engine::init() {
   // world_seed was already resolved from voxel.properties (blank = random).
-  srand(g_settings.world_seed);
   // Offset noise coordinates to get a unique world each seed.
   // Capped at 5000 units — large enough for variety, small enough to avoid
   // degenerate all-ocean regions that appear at extreme offsets.
@@ -31,6 +31,10 @@ bool Engine::init() {
   );
   // Note: a loaded save overrides seed/noise_offset in run() before world gen.
 
+  // Terrain noise runs through the batch kernels; make sure they still match
+  // glm::perlin before any chunk is generated (falls back to scalar if not).
+  NoiseBatch::selfCheck();
+
   if (!glfwInit()) {
     std::cerr << "Failed to initialize GLFW\n";
     return false;
@@ -125,7 +129,6 @@ void Engine::run() {
   if (WorldSave::loadLevel(save_dir, level)) {
     g_settings.world_seed   = level.seed;
     g_settings.noise_offset = level.noise_offset;
-    srand(level.seed);
     game_clock.time_of_day  = level.time_of_day;
 
     WorldEdits saved_edits;
@@ -142,6 +145,10 @@ void Engine::run() {
               << g_settings.world_seed << ")\n";
   }
 
+  if (g_settings.chunk_cache)
+    world.enableChunkCache(save_dir + "/cache",
+                           static_cast<size_t>(std::max(g_settings.chunk_cache_mb, 0)) << 20);
+
   world.init();
 
   while (!glfwWindowShouldClose(window)) {
@@ -389,6 +396,7 @@ void Engine::debug() {
           ImGui::Checkbox("Wireframe",  &g_settings.wireframe);
           ImGui::SameLine();
           ImGui::Checkbox("Fullscreen", &g_settings.fullscreen);
+          ImGui::Checkbox("Binary mesher", &g_settings.binary_mesher);
 
           ImGui::PushItemWidth(180);
           ImGui::SliderFloat("Fog start", &g_settings.fog_start,  0.f, 300.f, "%.0f");
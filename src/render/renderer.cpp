@@ -204,7 +204,7 @@ static bool aabbInFrustum(const glm::vec4 planes[6], const glm::vec3 &min,
 // ─── Shadow depth pass ─────────────────────────────────────────────────────
 
 void Renderer::shadowPass(
-    const robin_hood::unordered_map<ChunkKey, std::shared_ptr<Chunk>, ChunkKeyHash> &chunks,
+    const std::vector<Chunk *> &chunks,
     const glm::vec3 &cameraPos, float timeOfDay,
     int viewportWidth, int viewportHeight)
 {
@@ -255,12 +255,12 @@ void Renderer::shadowPass(
   glm::vec4 lightPlanes[6];
   extractFrustumPlanes(light_space_matrix, lightPlanes);
 
-  for (auto &[key, chunk] : chunks) {
-    if (!chunk) continue;
-    glm::vec3 min = {key.x * kChunkWidth, 0.0f, key.z * kChunkDepth};
+  for (Chunk *chunk : chunks) {
+    const glm::ivec2 key = chunk->getPos();
+    glm::vec3 min = {key.x * kChunkWidth, 0.0f, key.y * kChunkDepth};
     glm::vec3 max = {(key.x + 1) * kChunkWidth,
                      static_cast<float>(kChunkHeight),
-                     (key.z + 1) * kChunkDepth};
+                     (key.y + 1) * kChunkDepth};
     if (!aabbInFrustum(lightPlanes, min, max)) continue;
     chunk->getMesh().renderOpaque();
     ++stats.shadow_chunks_drawn;
@@ -0,0 +1,262 @@
+#include "util/noise_batch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/noise.hpp>
+#include <iostream>
+#include <vector>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// ─── Lanes ──────────────────────────────────────────────────────────────────
+// A handful of float ops over kWidth lanes; the noise kernels below are
+// written once against this interface.
+
+#if defined(__AVX__)
+struct Lanes {
+  static constexpr size_t kWidth = 8;
+  __m256 v;
+  Lanes() = default;
+  Lanes(__m256 v) : v(v) {}
+  Lanes(float f) : v(_mm256_set1_ps(f)) {}
+  static Lanes load(const float *p) { return _mm256_loadu_ps(p); }
+  void store(float *p) const { _mm256_storeu_ps(p, v); }
+  friend Lanes operator+(Lanes a, Lanes b) { return _mm256_add_ps(a.v, b.v); }
+  friend Lanes operator-(Lanes a, Lanes b) { return _mm256_sub_ps(a.v, b.v); }
+  friend Lanes operator*(Lanes a, Lanes b) { return _mm256_mul_ps(a.v, b.v); }
+  friend Lanes operator/(Lanes a, Lanes b) { return _mm256_div_ps(a.v, b.v); }
+  friend Lanes floor(Lanes a) { return _mm256_floor_ps(a.v); }
+  friend Lanes abs(Lanes a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+  // GLSL step(): 0 where x < edge, else 1.
+  friend Lanes step(Lanes edge, Lanes x) {
+    return _mm256_and_ps(_mm256_cmp_ps(x.v, edge.v, _CMP_GE_OQ), _mm256_set1_ps(1.0f));
+  }
+};
+#elif defined(__SSE2__)
+struct Lanes {
+  static constexpr size_t kWidth = 4;
+  __m128 v;
+  Lanes() = default;
+  Lanes(__m128 v) : v(v) {}
+  Lanes(float f) : v(_mm_set1_ps(f)) {}
+  static Lanes load(const float *p) { return _mm_loadu_ps(p); }
+  void store(float *p) const { _mm_storeu_ps(p, v); }
+  friend Lanes operator+(Lanes a, Lanes b) { return _mm_add_ps(a.v, b.v); }
+  friend Lanes operator-(Lanes a, Lanes b) { return _mm_sub_ps(a.v, b.v); }
+  friend Lanes operator*(Lanes a, Lanes b) { return _mm_mul_ps(a.v, b.v); }
+  friend Lanes operator/(Lanes a, Lanes b) { return _mm_div_ps(a.v, b.v); }
+  // No SSE2 floor: truncate, then step down where that rounded up. Exact for
+  // |a| < 2^31, far beyond any noise coordinate.
+  friend Lanes floor(Lanes a) {
+    const __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a.v), _mm_set1_ps(1.0f)));
+  }
+  friend Lanes abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+  friend Lanes step(Lanes edge, Lanes x) {
+    return _mm_and_ps(_mm_cmpge_ps(x.v, edge.v), _mm_set1_ps(1.0f));
+  }
+};
+#else
+struct Lanes {
+  static constexpr size_t kWidth = 1;
+  float v;
+  Lanes() = default;
+  Lanes(float f) : v(f) {}
+  static Lanes load(const float *p) { return *p; }
+  void store(float *p) const { *p = v; }
+  friend Lanes operator+(Lanes a, Lanes b) { return a.v + b.v; }
+  friend Lanes operator-(Lanes a, Lanes b) { return a.v - b.v; }
+  friend Lanes operator*(Lanes a, Lanes b) { return a.v * b.v; }
+  friend Lanes operator/(Lanes a, Lanes b) { return a.v / b.v; }
+  friend Lanes floor(Lanes a) { return std::floor(a.v); }
+  friend Lanes abs(Lanes a) { return std::fabs(a.v); }
+  friend Lanes step(Lanes edge, Lanes x) { return x.v < edge.v ? 0.0f : 1.0f; }
+};
+#endif
+
+// ─── Kernels ────────────────────────────────────────────────────────────────
+// Step for step the same arithmetic as glm's perlin (Gustavson's classic
+// noise), so results agree with it to within float rounding.
+
+Lanes fract(Lanes x) { return x - floor(x); }
+Lanes mix(Lanes a, Lanes b, Lanes t) { return a * (1.0f - t) + b * t; }
+Lanes mod289(Lanes x) { return x - floor(x * (1.0f / 289.0f)) * 289.0f; }
+Lanes wrap289(Lanes x) { return x - 289.0f * floor(x / 289.0f); } // glm::mod(x, 289)
+Lanes permute(Lanes x) { return mod289((x * 34.0f + 1.0f) * x); }
+Lanes taylorInvSqrt(Lanes r) { return 1.79284291400159f - 0.85373472095314f * r; }
+Lanes fade(Lanes t) { return (t * t * t) * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+// Gradient term of one 2D lattice corner.
+Lanes corner2(Lanes ix, Lanes iy, Lanes fx, Lanes fy) {
+  const Lanes i = permute(permute(ix) + iy);
+  Lanes gx = 2.0f * fract(i / 41.0f) - 1.0f;
+  const Lanes gy = abs(gx) - 0.5f;
+  gx = gx - floor(gx + 0.5f);
+  const Lanes norm = taylorInvSqrt(gx * gx + gy * gy);
+  return (gx * norm) * fx + (gy * norm) * fy;
+}
+
+Lanes perlin2(Lanes x, Lanes y) {
+  const Lanes x0 = floor(x), y0 = floor(y);
+  const Lanes ix0 = wrap289(x0), iy0 = wrap289(y0);
+  const Lanes ix1 = wrap289(x0 + 1.0f), iy1 = wrap289(y0 + 1.0f);
+  const Lanes fx0 = x - x0, fy0 = y - y0;
+  const Lanes fx1 = fx0 - 1.0f, fy1 = fy0 - 1.0f;
+
+  const Lanes n00 = corner2(ix0, iy0, fx0, fy0);
+  const Lanes n10 = corner2(ix1, iy0, fx1, fy0);
+  const Lanes n01 = corner2(ix0, iy1, fx0, fy1);
+  const Lanes n11 = corner2(ix1, iy1, fx1, fy1);
+
+  const Lanes ux = fade(fx0), uy = fade(fy0);
+  return 2.3f * mix(mix(n00, n10, ux), mix(n01, n11, ux), uy);
+}
+
+// Gradient term of one 3D lattice corner; `ixy` is the corner's hashed x/y.
+Lanes corner3(Lanes ixy, Lanes iz, Lanes fx, Lanes fy, Lanes fz) {
+  const Lanes h = permute(ixy + iz);
+  Lanes gx = h * (1.0f / 7.0f);
+  Lanes gy = fract(floor(gx) * (1.0f / 7.0f)) - 0.5f;
+  gx = fract(gx);
+  const Lanes gz = 0.5f - abs(gx) - abs(gy);
+  const Lanes sz = step(gz, 0.0f);
+  gx = gx - sz * (step(0.0f, gx) - 0.5f);
+  gy = gy - sz * (step(0.0f, gy) - 0.5f);
+  const Lanes norm = taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+  return gx * norm * fx + gy * norm * fy + gz * norm * fz;
+}
+
+Lanes perlin3(Lanes x, Lanes y, Lanes z) {
+  const Lanes x0 = floor(x), y0 = floor(y), z0 = floor(z);
+  const Lanes ix0 = wrap289(x0), iy0 = wrap289(y0), iz0 = wrap289(z0);
+  const Lanes ix1 = wrap289(x0 + 1.0f), iy1 = wrap289(y0 + 1.0f),
+              iz1 = wrap289(z0 + 1.0f);
+  const Lanes fx0 = x - x0, fy0 = y - y0, fz0 = z - z0;
+  const Lanes fx1 = fx0 - 1.0f, fy1 = fy0 - 1.0f, fz1 = fz0 - 1.0f;
+
+  const Lanes px0 = permute(ix0), px1 = permute(ix1);
+  const Lanes h00 = permute(px0 + iy0), h10 = permute(px1 + iy0);
+  const Lanes h01 = permute(px0 + iy1), h11 = permute(px1 + iy1);
+
+  const Lanes uz = fade(fz0);
+  const Lanes n00 = mix(corner3(h00, iz0, fx0, fy0, fz0), corner3(h00, iz1, fx0, fy0, fz1), uz);
+  const Lanes n10 = mix(corner3(h10, iz0, fx1, fy0, fz0), corner3(h10, iz1, fx1, fy0, fz1), uz);
+  const Lanes n01 = mix(corner3(h01, iz0, fx0, fy1, fz0), corner3(h01, iz1, fx0, fy1, fz1), uz);
+  const Lanes n11 = mix(corner3(h11, iz0, fx1, fy1, fz0), corner3(h11, iz1, fx1, fy1, fz1), uz);
+
+  const Lanes uy = fade(fy0), ux = fade(fx0);
+  return 2.2f * mix(mix(n00, n01, uy), mix(n10, n11, uy), ux);
+}
+
+Lanes fbm3(Lanes x, Lanes y, Lanes z, int octaves, float lacunarity, float gain) {
+  Lanes sum = 0.0f;
+  float amplitude = 1.0f, frequency = 1.0f, norm = 0.0f;
+  for (int i = 0; i < octaves; ++i) {
+    sum = sum + amplitude * (perlin3(x * frequency, y * frequency, z * frequency) * 0.5f + 0.5f);
+    norm += amplitude;
+    amplitude *= gain;
+    frequency *= lacunarity;
+  }
+  return sum * (1.0f / norm);
+}
+
+// ─── Drivers ────────────────────────────────────────────────────────────────
+
+bool use_kernels = true; // cleared by a failed selfCheck()
+
+// Runs `kernel` over n points, kWidth at a time. A short tail is padded out
+// to a full vector so every point goes through the same arithmetic.
+template <size_t N, class Kernel>
+void forEachBatch(const float *const (&in)[N], float *out, size_t n,
+                  Kernel &&kernel) {
+  constexpr size_t W = Lanes::kWidth;
+  size_t i = 0;
+  for (; i + W <= n; i += W) {
+    Lanes args[N];
+    for (size_t k = 0; k < N; ++k) args[k] = Lanes::load(in[k] + i);
+    kernel(args).store(out + i);
+  }
+  if (i == n) return;
+  float tail[N][W] = {}, result[W];
+  for (size_t k = 0; k < N; ++k) std::copy(in[k] + i, in[k] + n, tail[k]);
+  Lanes args[N];
+  for (size_t k = 0; k < N; ++k) args[k] = Lanes::load(tail[k]);
+  kernel(args).store(result);
+  std::copy(result, result + (n - i), out + i);
+}
+
+} // namespace
+
+namespace NoiseBatch {
+
+void perlin2(const float *x, const float *y, float *out, size_t n) {
+  if (!use_kernels) {
+    for (size_t i = 0; i < n; ++i) out[i] = glm::perlin(glm::vec2(x[i], y[i]));
+    return;
+  }
+  forEachBatch({x, y}, out, n, [](const Lanes *p) { return ::perlin2(p[0], p[1]); });
+}
+
+void perlin3(const float *x, const float *y, const float *z, float *out,
+             size_t n) {
+  if (!use_kernels) {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = glm::perlin(glm::vec3(x[i], y[i], z[i]));
+    return;
+  }
+  forEachBatch({x, y, z}, out, n,
+               [](const Lanes *p) { return ::perlin3(p[0], p[1], p[2]); });
+}
+
+void fbm3(const float *x, const float *y, const float *z, float *out, size_t n,
+          int octaves, float lacunarity, float gain) {
+  if (!use_kernels) {
+    for (size_t i = 0; i < n; ++i) {
+      float sum = 0.0f, amplitude = 1.0f, frequency = 1.0f, norm = 0.0f;
+      for (int o = 0; o < octaves; ++o) {
+        const glm::vec3 p(x[i] * frequency, y[i] * frequency, z[i] * frequency);
+        sum += amplitude * (glm::perlin(p) * 0.5f + 0.5f);
+        norm += amplitude;
+        amplitude *= gain;
+        frequency *= lacunarity;
+      }
+      out[i] = sum / norm;
+    }
+    return;
+  }
+  forEachBatch({x, y, z}, out, n, [&](const Lanes *p) {
+    return ::fbm3(p[0], p[1], p[2], octaves, lacunarity, gain);
+  });
+}
+
+bool selfCheck() {
+  // Points spread over negative and large coordinates, including exact
+  // lattice points and the 289-period wrap.
+  constexpr size_t kPoints = 4096;
+  std::vector<float> x(kPoints), y(kPoints), z(kPoints), out(kPoints);
+  for (size_t i = 0; i < kPoints; ++i) {
+    x[i] = static_cast<float>(i % 64) * 0.37f - 300.0f + static_cast<float>(i / 64) * 9.1f;
+    y[i] = static_cast<float>(i % 17) * 0.53f - 4.0f;
+    z[i] = i % 5 == 0 ? std::floor(x[i]) : x[i] * -0.71f + 12.3f;
+  }
+
+  constexpr float kTolerance = 1e-4f;
+  float worst2 = 0.0f, worst3 = 0.0f;
+  perlin2(x.data(), y.data(), out.data(), kPoints);
+  for (size_t i = 0; i < kPoints; ++i)
+    worst2 = std::max(worst2, std::fabs(out[i] - glm::perlin(glm::vec2(x[i], y[i]))));
+  perlin3(x.data(), y.data(), z.data(), out.data(), kPoints);
+  for (size_t i = 0; i < kPoints; ++i)
+    worst3 = std::max(worst3, std::fabs(out[i] - glm::perlin(glm::vec3(x[i], y[i], z[i]))));
+
+  if (worst2 <= kTolerance && worst3 <= kTolerance) return true;
+  std::cerr << "[noise] batch kernels disagree with glm::perlin (max error "
+            << worst2 << " 2D, " << worst3
+            << " 3D); falling back to scalar noise\n";
+  use_kernels = false;
+  return false;
+}
+
+} // namespace NoiseBatch
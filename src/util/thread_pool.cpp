@@ -1,37 +1,123 @@
 #include "util/thread_pool.hpp"
+#include <algorithm>
+
+namespace {
+
+// Which pool the current thread works for, and its queue index there, so jobs
+// queued from inside a job land on the submitting worker's own queue.
+thread_local const ThreadPool *tl_pool = nullptr;
+thread_local size_t tl_index = 0;
+
+} // namespace
 
 ThreadPool::ThreadPool(size_t numThreads) {
-  for (size_t i = 0; i < numThreads; ++i) {
-    workers.emplace_back([this]() {
-      while (true) {
-        std::function<void()> job;
-        {
-          std::unique_lock<std::mutex> lock(queue_mutex);
-          condition.wait(lock, [this]() { return stop || !jobs.empty(); });
-          // On shutdown, finish the current job (already popped) but drop any
-          // still queued — they touch world state that is about to be freed.
-          if (stop)
-            return;
-          job = std::move(jobs.front());
-          jobs.pop();
-        }
-        job();
+  numThreads = std::max<size_t>(numThreads, 1);
+  for (size_t i = 0; i < numThreads; ++i)
+    queues.push_back(std::make_unique<Queue>());
+  for (size_t i = 0; i < numThreads; ++i)
+    workers.emplace_back([this, i]() { run(i); });
+}
+
+void ThreadPool::push(Task &&task, int priority) {
+  if (stop.load(std::memory_order_relaxed))
+    return;
+
+  const size_t target = tl_pool == this
+                            ? tl_index
+                            : next_queue.fetch_add(1, std::memory_order_relaxed) %
+                                  queues.size();
+  Queue &queue = *queues[target];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.heap.push_back(
+        {priority, next_seq.fetch_add(1, std::memory_order_relaxed),
+         std::move(task)});
+    std::push_heap(queue.heap.begin(), queue.heap.end());
+    pending.fetch_add(1, std::memory_order_release);
+  }
+
+  // Taking the sleep lock orders this push against a worker that is about to
+  // wait, so the notification can't be lost.
+  { std::lock_guard<std::mutex> lock(sleep_mutex); }
+  wake.notify_one();
+}
+
+bool ThreadPool::popFrom(Queue &queue, Task &out) {
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.heap.empty())
+    return false;
+  std::pop_heap(queue.heap.begin(), queue.heap.end());
+  out = std::move(queue.heap.back().task);
+  queue.heap.pop_back();
+  pending.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool ThreadPool::tryPop(size_t self, Task &out) {
+  // Take the most urgent head across all queues. seq is pool-wide, so equal
+  // priorities still run in submission order, and a near chunk never waits
+  // behind this worker's distant ones. Another worker may pop that head
+  // first; then look again.
+  while (pending.load(std::memory_order_acquire) > 0) {
+    Queue *best = nullptr;
+    int best_priority = 0;
+    uint64_t best_seq = 0;
+    for (size_t i = 0; i < queues.size(); ++i) {
+      Queue &queue = *queues[(self + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.heap.empty())
+        continue;
+      const Job &head = queue.heap.front();
+      if (!best || head.priority < best_priority ||
+          (head.priority == best_priority && head.seq < best_seq)) {
+        best = &queue;
+        best_priority = head.priority;
+        best_seq = head.seq;
       }
+    }
+    if (!best)
+      return false;
+    if (popFrom(*best, out))
+      return true;
+  }
+  return false;
+}
+
+void ThreadPool::run(size_t self) {
+  tl_pool = this;
+  tl_index = self;
+  while (true) {
+    // On shutdown, finish the current job (already popped) but drop any
+    // still queued — they touch world state that is about to be freed.
+    if (stop.load(std::memory_order_acquire))
+      return;
+
+    Task job;
+    if (tryPop(self, job)) {
+      job();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    wake.wait(lock, [this]() {
+      return stop.load(std::memory_order_acquire) ||
+             pending.load(std::memory_order_acquire) > 0;
     });
   }
 }
 
 void ThreadPool::shutdown() {
   {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    if (stop)
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    if (stop.exchange(true))
       return; // already shut down
-    stop = true;
   }
-  condition.notify_all();
+  wake.notify_all();
   for (auto &worker : workers)
     if (worker.joinable())
       worker.join();
+  for (auto &queue : queues)
+    queue->heap.clear();
 }
 
 ThreadPool::~ThreadPool() { shutdown(); }
@@ -0,0 +1,268 @@
+#include "world/chunk_cache.hpp"
+#include "core/constants.hpp"
+#include "core/settings.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// ─── File format ────────────────────────────────────────────────────────────
+// header, then the blocks in linear index order as runs of (type, varint
+// length), then the overflow as a count and (x, y, z, type) records.
+constexpr char kCacheMagic[4] = {'V', 'X', 'C', 'C'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kVolume = kChunkWidth * kChunkHeight * kChunkDepth;
+
+struct Header {
+  char magic[4];
+  uint32_t format;
+  uint32_t generator;
+  uint32_t seed;
+  float offset_x, offset_z;
+  int32_t cx, cz;
+};
+
+Header currentHeader(const ChunkKey &key) {
+  Header h;
+  std::memcpy(h.magic, kCacheMagic, 4);
+  h.format = kFormatVersion;
+  h.generator = kGeneratorVersion;
+  h.seed = g_settings.world_seed;
+  h.offset_x = g_settings.noise_offset.x;
+  h.offset_z = g_settings.noise_offset.y;
+  h.cx = key.x;
+  h.cz = key.z;
+  return h;
+}
+
+template <class T> void put(std::string &out, const T &v) {
+  out.append(reinterpret_cast<const char *>(&v), sizeof(T));
+}
+
+void putVarint(std::string &out, uint32_t v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<char>(v));
+}
+
+// Bounds-checked cursor over a file's bytes; every read fails once past the end.
+struct Reader {
+  const char *p, *end;
+
+  template <class T> bool get(T &v) {
+    if (end - p < static_cast<ptrdiff_t>(sizeof(T))) return false;
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+  }
+  bool getVarint(uint32_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+      const uint8_t b = static_cast<uint8_t>(*p++);
+      v |= static_cast<uint32_t>(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+};
+
+bool validBlock(uint8_t b) {
+  return b <= static_cast<uint8_t>(BlockType::CHERRY_LEAF);
+}
+
+} // namespace
+
+ChunkCache::ChunkCache(std::string dir_, size_t max_bytes)
+    : dir(std::move(dir_)), max_bytes(max_bytes) {
+  std::error_code ec;
+  fs::create_directories(dir, ec);
+  if (ec) {
+    std::cerr << "[cache] cannot create '" << dir << "': " << ec.message()
+              << "\n";
+    return;
+  }
+
+  // Rebuild the LRU order from what a previous run left behind, oldest
+  // write first, and clear out writes that never finished.
+  struct Found {
+    ChunkKey key;
+    size_t bytes;
+    fs::file_time_type time;
+  };
+  std::vector<Found> found;
+  for (const auto &e : fs::directory_iterator(dir, ec)) {
+    const std::string name = e.path().filename().string();
+    int cx, cz, len = 0;
+    if (std::sscanf(name.c_str(), "%d_%d.chunk%n", &cx, &cz, &len) == 2 &&
+        len == static_cast<int>(name.size())) {
+      found.push_back({{cx, cz}, static_cast<size_t>(e.file_size(ec)),
+                       e.last_write_time(ec)});
+    } else if (name.find(".tmp") != std::string::npos) {
+      fs::remove(e.path(), ec);
+    }
+  }
+  std::sort(found.begin(), found.end(),
+            [](const Found &a, const Found &b) { return a.time < b.time; });
+  for (const Found &f : found) touch(f.key, f.bytes);
+}
+
+std::string ChunkCache::pathOf(const ChunkKey &key) const {
+  return dir + "/" + std::to_string(key.x) + "_" + std::to_string(key.z) +
+         ".chunk";
+}
+
+void ChunkCache::touch(const ChunkKey &key, size_t bytes) {
+  auto it = entries.find(key);
+  if (it != entries.end()) {
+    total_bytes -= it->second.bytes;
+    lru.erase(it->second.pos);
+    entries.erase(it);
+  }
+  lru.push_front(key);
+  entries[key] = {lru.begin(), bytes};
+  total_bytes += bytes;
+}
+
+void ChunkCache::forget(const ChunkKey &key) {
+  auto it = entries.find(key);
+  if (it == entries.end()) return;
+  total_bytes -= it->second.bytes;
+  lru.erase(it->second.pos);
+  entries.erase(it);
+}
+
+// ─── Load ───────────────────────────────────────────────────────────────────
+bool ChunkCache::load(const ChunkKey &key, Chunk &chunk,
+                      std::vector<DecorationWrite> &overflow) {
+  size_t bytes;
+  {
+    Lock lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) return false; // never generated: skip the disk
+    bytes = it->second.bytes;
+  }
+
+  std::string data;
+  {
+    std::ifstream in(pathOf(key), std::ios::binary);
+    if (in) {
+      std::ostringstream ss;
+      ss << in.rdbuf();
+      data = ss.str();
+    }
+  }
+
+  // Decode fully before touching the chunk, so a bad file is just a miss.
+  thread_local std::vector<BlockType> blocks(kVolume);
+  std::vector<DecorationWrite> spilled;
+  auto decode = [&]() {
+    Reader r{data.data(), data.data() + data.size()};
+    const Header expected = currentHeader(key);
+    Header h;
+    if (!r.get(h) || std::memcmp(&h, &expected, sizeof(Header)) != 0)
+      return false;
+    for (uint32_t i = 0; i < kVolume;) {
+      uint8_t type;
+      uint32_t run;
+      if (!r.get(type) || !validBlock(type) || !r.getVarint(run) || run == 0 ||
+          run > kVolume - i)
+        return false;
+      std::fill_n(blocks.begin() + i, run, static_cast<BlockType>(type));
+      i += run;
+    }
+    uint32_t count;
+    if (!r.get(count)) return false;
+    spilled.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      int32_t x, z;
+      uint8_t y, type;
+      if (!r.get(x) || !r.get(y) || !r.get(z) || !r.get(type) || !validBlock(type))
+        return false;
+      spilled.push_back({{x, y, z}, static_cast<BlockType>(type)});
+    }
+    return r.p == r.end;
+  };
+
+  if (data.empty() || !decode()) {
+    // Stale (other seed or generator) or damaged: drop it for good.
+    Lock lock(mutex);
+    forget(key);
+    std::error_code ec;
+    fs::remove(pathOf(key), ec);
+    return false;
+  }
+
+  for (uint32_t i = 0; i < kVolume; ++i)
+    if (blocks[i] != BlockType::AIR) chunk.setBlockLinear(i, blocks[i]);
+  chunk.advanceState(ChunkState::Queued, ChunkState::Generated);
+  chunk.advanceState(ChunkState::Generated, ChunkState::Decorated);
+  overflow.insert(overflow.end(), spilled.begin(), spilled.end());
+
+  Lock lock(mutex);
+  touch(key, bytes);
+  return true;
+}
+
+// ─── Store ──────────────────────────────────────────────────────────────────
+void ChunkCache::store(const ChunkKey &key, const Chunk &chunk,
+                       const std::vector<DecorationWrite> &overflow) {
+  thread_local std::vector<BlockType> blocks(kVolume);
+  chunk.decodeBlocks(blocks.data());
+
+  std::string data;
+  put(data, currentHeader(key));
+  for (uint32_t i = 0; i < kVolume;) {
+    uint32_t run = 1;
+    while (i + run < kVolume && blocks[i + run] == blocks[i]) ++run;
+    put(data, static_cast<uint8_t>(blocks[i]));
+    putVarint(data, run);
+    i += run;
+  }
+  put(data, static_cast<uint32_t>(overflow.size()));
+  for (const DecorationWrite &w : overflow) {
+    put(data, static_cast<int32_t>(w.pos.x));
+    put(data, static_cast<uint8_t>(w.pos.y));
+    put(data, static_cast<int32_t>(w.pos.z));
+    put(data, static_cast<uint8_t>(w.type));
+  }
+
+  // Written aside and renamed into place, so readers never see half a file.
+  const std::string path = pathOf(key);
+  const std::string temp = path + ".tmp" + std::to_string(temp_counter++);
+  {
+    std::ofstream o(temp, std::ios::binary | std::ios::trunc);
+    if (!o || !o.write(data.data(), data.size())) {
+      std::error_code ec;
+      fs::remove(temp, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  fs::rename(temp, path, ec);
+  if (ec) {
+    fs::remove(temp, ec);
+    return;
+  }
+
+  std::vector<std::string> evicted;
+  {
+    Lock lock(mutex);
+    touch(key, data.size());
+    while (total_bytes > max_bytes && lru.size() > 1) {
+      const ChunkKey victim = lru.back();
+      forget(victim);
+      evicted.push_back(pathOf(victim));
+    }
+  }
+  for (const std::string &p : evicted)
+    fs::remove(p, ec);
+}
@@ -0,0 +1,133 @@
+#include "world/chunk_map.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Reader slot indices are per thread and shared by every ChunkMap; a thread
+// hands its index back when it exits so short-lived threads can't run out.
+constexpr size_t kSlotCount = 128;
+std::array<std::atomic<bool>, kSlotCount> g_slot_taken{};
+
+struct ThreadSlot {
+  size_t index = 0;
+  ThreadSlot() {
+    for (bool warned = false;; std::this_thread::yield()) {
+      for (size_t i = 0; i < kSlotCount; ++i)
+        if (!g_slot_taken[i].exchange(true, std::memory_order_acquire)) {
+          index = i;
+          return;
+        }
+      if (!warned) {
+        std::cerr << "[chunk_map] more than " << kSlotCount
+                  << " reader threads; waiting for a free slot\n";
+        warned = true;
+      }
+    }
+  }
+  ~ThreadSlot() { g_slot_taken[index].store(false, std::memory_order_release); }
+};
+
+} // namespace
+
+size_t ChunkMap::threadSlot() {
+  static_assert(kSlotCount == kMaxReaders);
+  thread_local ThreadSlot slot;
+  return slot.index;
+}
+
+ChunkMap::ReadGuard::ReadGuard(const ChunkMap &map) {
+  std::atomic<uint64_t> &s = map.readers[threadSlot()].epoch;
+  if (s.load(std::memory_order_relaxed) != kIdle)
+    return; // nested: the outer guard already pins this thread
+  // Sequentially consistent, so collect() either sees this slot or this
+  // thread sees every table published before that collect().
+  s.store(map.epoch.load());
+  slot = &s;
+}
+
+ChunkMap::ReadGuard::~ReadGuard() {
+  if (slot) slot->store(kIdle, std::memory_order_release);
+}
+
+ChunkMap::ChunkMap() {
+  for (Shard &shard : shards)
+    shard.table.store(new Table());
+}
+
+ChunkMap::~ChunkMap() {
+  for (Shard &shard : shards)
+    delete shard.table.load();
+  for (auto &[stamp, table] : retired)
+    delete table;
+}
+
+std::shared_ptr<Chunk> ChunkMap::get(const ChunkKey &key) const {
+  ReadGuard guard(*this);
+  const Table &table = *shards[shardOf(key)].table.load();
+  auto it = table.find(key);
+  return it == table.end() ? nullptr : it->second;
+}
+
+bool ChunkMap::contains(const ChunkKey &key) const {
+  ReadGuard guard(*this);
+  return find(key) != nullptr;
+}
+
+bool ChunkMap::insert(const ChunkKey &key, std::shared_ptr<Chunk> chunk) {
+  Shard &shard = shards[shardOf(key)];
+  std::lock_guard<std::mutex> lock(shard.write_mutex);
+  const Table *old = shard.table.load(std::memory_order_relaxed);
+  if (old->count(key))
+    return false;
+
+  auto *next = new Table(*old);
+  next->emplace(key, std::move(chunk));
+  shard.table.store(next);
+  count.fetch_add(1, std::memory_order_relaxed);
+  retire(old);
+  return true;
+}
+
+std::shared_ptr<Chunk> ChunkMap::erase(const ChunkKey &key) {
+  Shard &shard = shards[shardOf(key)];
+  std::lock_guard<std::mutex> lock(shard.write_mutex);
+  const Table *old = shard.table.load(std::memory_order_relaxed);
+  auto it = old->find(key);
+  if (it == old->end())
+    return nullptr;
+  std::shared_ptr<Chunk> removed = it->second;
+
+  auto *next = new Table(*old);
+  next->erase(key);
+  shard.table.store(next);
+  count.fetch_sub(1, std::memory_order_relaxed);
+  retire(old);
+  return removed;
+}
+
+void ChunkMap::retire(const Table *table) {
+  std::lock_guard<std::mutex> lock(retired_mutex);
+  // Readers that entered at or before this stamp may still hold `table`.
+  retired.emplace_back(epoch.fetch_add(1), table);
+}
+
+void ChunkMap::collect() {
+  uint64_t oldest = kIdle;
+  for (const ReaderSlot &reader : readers)
+    oldest = std::min(oldest, reader.epoch.load());
+
+  std::vector<const Table *> dead;
+  {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    auto keep = std::partition(retired.begin(), retired.end(),
+                               [&](const auto &r) { return r.first >= oldest; });
+    for (auto it = keep; it != retired.end(); ++it)
+      dead.push_back(it->second);
+    retired.erase(keep, retired.end());
+  }
+  // Dropping the last table referencing an erased chunk destroys it here.
+  for (const Table *table : dead)
+    delete table;
+}
@@ -0,0 +1,307 @@
+#include "world/light_engine.hpp"
+#include "block/block_data.hpp"
+#include <algorithm>
+#include <cmath>
+
+LightEngine::LightEngine(ChunkMap &chunks)
+    : chunks(chunks), remove_queue(1 << 12), add_queue(1 << 12) {
+  for (auto &column : grid)
+    for (Slot &slot : column) {
+      slot.blocks.resize(kChunkWidth * kChunkHeight * kChunkDepth);
+      slot.light.resize(kChunkWidth * kChunkHeight * kChunkDepth);
+    }
+}
+
+// ─── Region access ──────────────────────────────────────────────────────────
+
+void LightEngine::beginRegion(int cx, int cz) {
+  region_x = cx - 1;
+  region_z = cz - 1;
+  for (int i = 0; i < kSpan; ++i)
+    for (int j = 0; j < kSpan; ++j) {
+      Slot &slot = grid[i][j];
+      slot.chunk = chunks.find({region_x + i, region_z + j});
+      slot.copied.fill(false);
+      slot.changed.fill(false);
+      if (!slot.chunk) continue;
+
+      const Chunk &c = *slot.chunk;
+      ReadLock lock(slot.chunk->data_mutex);
+      for (int z = 0; z < kChunkDepth; ++z)
+        for (int x = 0; x < kChunkWidth; ++x) {
+          slot.top_non_air[x + kChunkWidth * z] = static_cast<int16_t>(c.topNonAir(x, z));
+          slot.top_opaque[x + kChunkWidth * z] = static_cast<int16_t>(c.topOpaque(x, z));
+        }
+      slot.max_height = c.maxHeight();
+    }
+}
+
+void LightEngine::copySection(Slot &slot, int s) {
+  const uint32_t begin = static_cast<uint32_t>(s) * kSectionVolume;
+  ReadLock lock(slot.chunk->data_mutex);
+  slot.chunk->getSection(s).decode(slot.blocks.data() + begin);
+  const uint8_t *src = slot.chunk->lightData() + begin;
+  std::copy(src, src + kSectionVolume, slot.light.begin() + begin);
+  slot.copied[s] = true;
+}
+
+void LightEngine::commitRegion(std::vector<ChunkKey> &dirty) {
+  // Blocks may have changed since they were copied. That's fine: the edit
+  // that changed them has its own job queued behind this one, and it expects
+  // exactly the light this one computed.
+  for (auto &column : grid)
+    for (Slot &slot : column) {
+      if (!slot.chunk) continue;
+      if (std::find(slot.changed.begin(), slot.changed.end(), true) !=
+          slot.changed.end()) {
+        WriteLock lock(slot.chunk->data_mutex);
+        for (int s = 0; s < kSectionCount; ++s) {
+          if (!slot.changed[s]) continue;
+          const uint32_t begin = static_cast<uint32_t>(s) * kSectionVolume;
+          slot.chunk->setLightData(slot.light.data() + begin, begin, kSectionVolume);
+        }
+      }
+      slot.chunk = nullptr;
+    }
+
+  for (int i = 0; i < kSpan + 2; ++i)
+    for (int j = 0; j < kSpan + 2; ++j)
+      if (dirty_marks[i][j]) {
+        dirty.push_back({region_x - 1 + i, region_z - 1 + j});
+        dirty_marks[i][j] = false;
+      }
+}
+
+uint8_t LightEngine::get(Channel ch, Voxel v) {
+  const uint8_t l = loaded(v).light[chunkIndex(v)];
+  return ch == Channel::Sky ? skyLightOf(l) : blockLightOf(l);
+}
+
+void LightEngine::set(Channel ch, Voxel v, uint8_t level) {
+  if (get(ch, v) == level) return;
+  Slot &slot = slotOf(v); // copied in by get() above
+  slot.changed[yOf(v) / kSectionHeight] = true;
+  uint8_t &l = slot.light[chunkIndex(v)];
+  l = ch == Channel::Sky ? packLight(level, blockLightOf(l))
+                         : packLight(skyLightOf(l), level);
+  markDirty(v);
+}
+
+uint8_t LightEngine::source(Channel ch, Voxel v) {
+  if (ch == Channel::Block)
+    return blockLightEmission(blockAt(v));
+
+  // Same rule as Chunk::computeSkyLight's column scan: full sky above the
+  // column, dimmed by every semi-transparent block on the way down.
+  const Slot &c = slotOf(v);
+  const int vy = yOf(v);
+  const int top = c.topNonAir(xOf(v) % kChunkWidth, zOf(v) % kChunkDepth);
+  if (vy > top) return 15;
+  if (vy <= c.topOpaque(xOf(v) % kChunkWidth, zOf(v) % kChunkDepth)) return 0;
+  int level = 15;
+  for (int y = top; y >= vy && level > 0; --y)
+    level -= opacity(voxel(xOf(v), y, zOf(v)));
+  return static_cast<uint8_t>(std::max(level, 0));
+}
+
+void LightEngine::directColumn(Voxel c, int y_top, int override_y,
+                               BlockType override_type, uint8_t *out) const {
+  Chunk &chunk = *slotOf(c).chunk;
+  ReadLock lock(chunk.data_mutex);
+  const int lx = xOf(c) % kChunkWidth, lz = zOf(c) % kChunkDepth;
+  const int top = std::max(chunk.topNonAir(lx, lz), override_y);
+  int level = 15;
+  for (int y = top; y >= 0; --y) {
+    if (level > 0) {
+      const BlockType b = y == override_y ? override_type : chunk.at(lx, y, lz);
+      const uint8_t op = skyLightOpacity(b);
+      level = op >= 15 ? 0 : std::max(level - op, 0);
+    }
+    if (y <= y_top) out[y] = static_cast<uint8_t>(level);
+  }
+  for (int y = top + 1; y <= y_top; ++y)
+    out[y] = 15;
+}
+
+// ─── Propagation ────────────────────────────────────────────────────────────
+
+void LightEngine::darken(Channel ch, Voxel v, uint8_t level) {
+  remove_queue.push(v | static_cast<uint32_t>(level) << kLevelShift);
+  set(ch, v, 0);
+  if (source(ch, v) > 0) relit_sources.push_back(v);
+}
+
+void LightEngine::removeLight(Channel ch) {
+  while (!remove_queue.empty()) {
+    const uint32_t entry = remove_queue.pop();
+    const Voxel v = entry & ((1u << kLevelShift) - 1);
+    const uint8_t level = static_cast<uint8_t>(entry >> kLevelShift);
+    forNeighbours(v, [&](Voxel n) {
+      const uint8_t nl = get(ch, n);
+      if (nl == 0) return;
+      // Dimmer neighbours may have been lit through v; brighter ones can't
+      // have been and now have to flood back into the darkened area.
+      if (nl < level)
+        darken(ch, n, nl);
+      else
+        add_queue.push(n);
+    });
+  }
+
+  for (Voxel v : relit_sources) {
+    const uint8_t s = source(ch, v);
+    if (s > get(ch, v)) {
+      set(ch, v, s);
+      add_queue.push(v);
+    }
+  }
+  relit_sources.clear();
+}
+
+void LightEngine::addLight(Channel ch) {
+  while (!add_queue.empty()) {
+    const Voxel v = add_queue.pop();
+    const uint8_t level = get(ch, v);
+    if (level <= 1) continue;
+    forNeighbours(v, [&](Voxel n) {
+      // Each hop decays by 1; semi-transparent blocks decay by 1+opacity.
+      const uint8_t op = opacity(n);
+      if (op >= 15 || level <= 1 + op) return;
+      const uint8_t nl = static_cast<uint8_t>(level - 1 - op);
+      if (nl > get(ch, n)) {
+        set(ch, n, nl);
+        add_queue.push(n);
+      }
+    });
+  }
+}
+
+void LightEngine::markDirty(Voxel v) {
+  // Meshes sample a one-voxel border from their neighbours, so an edge voxel
+  // dirties the chunk(s) across that edge too. Indices are offset by one for
+  // the border ring around the region.
+  const int i = xOf(v) / kChunkWidth + 1, j = zOf(v) / kChunkDepth + 1;
+  const int lx = xOf(v) % kChunkWidth, lz = zOf(v) % kChunkDepth;
+  const int di = lx == 0 ? -1 : lx == kChunkWidth - 1 ? 1 : 0;
+  const int dj = lz == 0 ? -1 : lz == kChunkDepth - 1 ? 1 : 0;
+  dirty_marks[i][j] = true;
+  dirty_marks[i + di][j] = true;
+  dirty_marks[i][j + dj] = true;
+  dirty_marks[i + di][j + dj] = true;
+}
+
+// ─── Operations ─────────────────────────────────────────────────────────────
+
+void LightEngine::blockChanged(const glm::ivec3 &pos, BlockType old_type,
+                               std::vector<ChunkKey> &dirty) {
+  const BlockChange change{pos, old_type};
+  blocksChanged(&change, 1, dirty);
+}
+
+void LightEngine::blocksChanged(const BlockChange *changes, size_t n,
+                                std::vector<ChunkKey> &dirty) {
+  ChunkMap::ReadGuard guard(chunks);
+  bool open = false;
+  int open_x = 0, open_z = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const glm::ivec3 &pos = changes[i].pos;
+    if (pos.y < 0 || pos.y >= kChunkHeight) continue;
+    const int cx = static_cast<int>(std::floor(static_cast<float>(pos.x) / kChunkWidth));
+    const int cz = static_cast<int>(std::floor(static_cast<float>(pos.z) / kChunkDepth));
+    if (!open || cx != open_x || cz != open_z) {
+      if (open) commitRegion(dirty);
+      beginRegion(cx, cz);
+      open = true;
+      open_x = cx;
+      open_z = cz;
+    }
+    if (grid[1][1].chunk) relight(changes[i]);
+  }
+  if (open) commitRegion(dirty);
+}
+
+void LightEngine::relight(const BlockChange &change) {
+  const Voxel p = voxel(change.pos.x - region_x * kChunkWidth, change.pos.y,
+                        change.pos.z - region_z * kChunkDepth);
+  markDirty(p);
+
+  // Direct sky below the edit is the only sky source it can change.
+  std::array<uint8_t, kChunkHeight> old_direct, new_direct;
+  directColumn(p, change.pos.y, change.pos.y, change.old_type, old_direct.data());
+  directColumn(p, change.pos.y, -1, BlockType::AIR, new_direct.data());
+
+  // Sky: darken the edited voxel and every column voxel whose direct light
+  // dropped, refill, then raise the column voxels that gained direct light.
+  darken(Channel::Sky, p, get(Channel::Sky, p));
+  for (int y = change.pos.y - 1; y >= 0; --y) {
+    const Voxel v = voxel(xOf(p), y, zOf(p));
+    if (new_direct[y] < old_direct[y]) darken(Channel::Sky, v, get(Channel::Sky, v));
+  }
+  removeLight(Channel::Sky);
+  for (int y = change.pos.y - 1; y >= 0; --y) {
+    const Voxel v = voxel(xOf(p), y, zOf(p));
+    if (new_direct[y] > old_direct[y] && new_direct[y] > get(Channel::Sky, v)) {
+      set(Channel::Sky, v, new_direct[y]);
+      add_queue.push(v);
+    }
+  }
+  addLight(Channel::Sky);
+
+  // Block light only changes at the edited voxel itself.
+  darken(Channel::Block, p, get(Channel::Block, p));
+  removeLight(Channel::Block);
+  addLight(Channel::Block);
+}
+
+void LightEngine::stitchLight(int cx, int cz, bool block_light,
+                              std::vector<ChunkKey> &dirty) {
+  ChunkMap::ReadGuard guard(chunks);
+  beginRegion(cx, cz);
+  if (!grid[1][1].chunk) {
+    commitRegion(dirty);
+    return;
+  }
+
+  // Both chunks were lit as if the other were solid, so light can only grow,
+  // and only where one side is bright enough to raise the voxel across the
+  // border. Seed just those voxels; every other border voxel stays untouched.
+  auto seedIfBrighter = [&](Channel ch, Voxel from, Voxel to) {
+    const int gap = get(ch, from) - get(ch, to) - 1;
+    if (gap > 0 && gap > opacity(to)) add_queue.push(from);
+  };
+  auto seedPair = [&](Channel ch, Voxel a, Voxel b) {
+    seedIfBrighter(ch, a, b);
+    seedIfBrighter(ch, b, a);
+  };
+  // Above both chunks' terrain every voxel is open sky, so sky light can only
+  // differ up to the taller one; block light reaches 15 blocks higher.
+  constexpr int lo = kChunkWidth, hi = 2 * kChunkWidth - 1; // the centre chunk
+  const int centre_top = grid[1][1].max_height;
+  auto stitchSide = [&](Channel ch, const Slot &side, auto pairAt) {
+    if (!side.chunk) return;
+    int top = std::max(centre_top, side.max_height);
+    if (ch == Channel::Block) top += 15;
+    top = std::min(top, kChunkHeight - 1);
+    for (int y = 0; y <= top; ++y)
+      for (int t = lo; t <= hi; ++t) pairAt(ch, y, t);
+  };
+  auto stitch = [&](Channel ch) {
+    stitchSide(ch, grid[0][1], [&](Channel c, int y, int t) {
+      seedPair(c, voxel(lo, y, t), voxel(lo - 1, y, t));
+    });
+    stitchSide(ch, grid[2][1], [&](Channel c, int y, int t) {
+      seedPair(c, voxel(hi, y, t), voxel(hi + 1, y, t));
+    });
+    stitchSide(ch, grid[1][0], [&](Channel c, int y, int t) {
+      seedPair(c, voxel(t, y, lo), voxel(t, y, lo - 1));
+    });
+    stitchSide(ch, grid[1][2], [&](Channel c, int y, int t) {
+      seedPair(c, voxel(t, y, hi), voxel(t, y, hi + 1));
+    });
+    addLight(ch);
+  };
+  stitch(Channel::Sky);
+  if (block_light) stitch(Channel::Block);
+
+  commitRegion(dirty);
+}
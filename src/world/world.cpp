@@ -7,6 +7,7 @@
 #include "render/renderer.hpp"
 #include "world/world_save.hpp"
 #include "util/lock.hpp"
+#include <algorithm>
 #include <cmath>
 #include <glm/fwd.hpp>
 #include <memory>
@@ -19,13 +20,16 @@ World::~World() {
   // Stop worker threads before any members (chunks, renderer, ...) unwind —
   // an in-flight mesh job dereferences them, so they must outlive the pools.
   gen_pool.shutdown();
+  light_pool.shutdown();
   mesh_pool.shutdown();
 }
 
 void World::init() {
   renderer->init();
 
-  spiral_offsets = generateSpiralOrder(g_settings.render_distance / kChunkWidth);
+  // One ring past the view distance: border chunks are generated so their
+  // inner neighbours can mesh, but never meshed themselves.
+  spiral_offsets = generateSpiralOrder(g_settings.render_distance / kChunkWidth + 1);
 
   glm::vec3 pos;
   if (has_loaded_player) {
@@ -33,37 +37,52 @@ void World::init() {
     // for a fresh spawn point.
     pos = loaded_player.position;
   } else {
-    // Spiral outward (by chunk) using only Biome::getHeight() — pure math, no
+    // Spiral outward (by chunk) using only the height noise — pure math, no
     // chunk allocation — until we find a chunk whose center is above sea level.
+    // Each ring's chunk centers are sampled in one Biome::sampleHeights batch.
     int spawn_cx = 0, spawn_cz = 0;
     constexpr int kMaxSpawnSearch = 200;
+    std::vector<glm::ivec2> ring;
+    std::vector<float> xs, zs, biome_noise;
+    std::vector<int> heights;
     for (int r = 0; r <= kMaxSpawnSearch; ++r) {
-      bool found = false;
-      for (int dx = -r; dx <= r && !found; ++dx) {
-        for (int dz = -r; dz <= r && !found; ++dz) {
+      ring.clear();
+      xs.clear();
+      zs.clear();
+      for (int dx = -r; dx <= r; ++dx)
+        for (int dz = -r; dz <= r; ++dz) {
           if (std::abs(dx) != r && std::abs(dz) != r) continue;
-          float wx = (dx + 0.5f) * kChunkWidth;
-          float wz = (dz + 0.5f) * kChunkDepth;
-          if (Biome::getHeight({wx, wz}) > kSeaLevel + 3) {
-            spawn_cx = dx;
-            spawn_cz = dz;
-            found = true;
-          }
+          ring.emplace_back(dx, dz);
+          xs.push_back((dx + 0.5f) * kChunkWidth);
+          zs.push_back((dz + 0.5f) * kChunkDepth);
         }
+      heights.resize(ring.size());
+      biome_noise.resize(ring.size());
+      Biome::sampleHeights(xs.data(), zs.data(), ring.size(), heights.data(),
+                           biome_noise.data());
+
+      auto land = std::find_if(heights.begin(), heights.end(),
+                               [](int h) { return h > kSeaLevel + 3; });
+      if (land != heights.end()) {
+        const glm::ivec2 c = ring[land - heights.begin()];
+        spawn_cx = c.x;
+        spawn_cz = c.y;
+        break;
       }
-      if (found) break;
     }
 
     // Generate that land chunk synchronously to scan actual block data.
     // Do NOT insert it into the chunks map — let preloadChunks handle it through
     // the normal async pipeline so its mesh gets built and uploaded properly.
     Chunk spawn_chunk(spawn_cx, spawn_cz);
-    spawn_chunk.init();
+    spawn_chunk.init(biome_map);
 
     // Scan all columns for grass/dirt with 2 clear air blocks above (player is
     // 1.8 blocks tall so we need y+1 and y+2 both to be air).
+    // Starts at the column's heightmap top: everything above it is air.
     auto scanColumn = [&](int lx, int lz, auto predicate) -> int {
-      for (int y = kChunkHeight - 3; y >= 1; --y) {
+      for (int y = std::min(kChunkHeight - 3, spawn_chunk.topNonAir(lx, lz));
+           y >= 1; --y) {
         BlockType surface = spawn_chunk.at(lx, y,     lz);
         BlockType above1  = spawn_chunk.at(lx, y + 1, lz);
         BlockType above2  = spawn_chunk.at(lx, y + 2, lz);
@@ -165,15 +184,51 @@ std::vector<glm::ivec2> World::generateSpiralOrder(int radius) {
   return spiral;
 }
 
+int World::chunkPriority(int cx, int cz) {
+  const int dx = cx - last_chunk_x;
+  const int dz = cz - last_chunk_z;
+  int priority = dx * dx + dz * dz;
+
+  // The ring the player stands in always goes first; beyond it, chunks the
+  // camera can't see wait behind visible ones of up to twice their distance.
+  if (priority > 2 * 2 && has_frustum) {
+    const glm::vec3 min = {cx * kChunkWidth, 0.0f, cz * kChunkDepth};
+    const glm::vec3 max = {(cx + 1) * kChunkWidth,
+                           static_cast<float>(kChunkHeight),
+                           (cz + 1) * kChunkDepth};
+    if (!isChunkInFrustum(frustum_planes, min, max))
+      priority *= 4;
+  }
+  return priority;
+}
+
 void World::addChunk(int x, int z) {
   ChunkKey key{x, z};
   auto chunk = std::make_shared<Chunk>(x, z);
+  const int priority = chunkPriority(x, z);
+  {
+    Lock lock(queue_mutex);
+    pending.emplace(key, chunk);
+  }
 
-  gen_pool.enqueue([this, chunk, key]() {
-    chunk->init(); // generate terrain
+  gen_pool.enqueue([this, chunk, key, priority]() {
+    if (chunk->isCancelled()) return; // left render distance while queued
+    std::vector<DecorationWrite> overflow;
+    // Back from the recently-unloaded cache. Its neighbours' stashes still
+    // hold what it spilled (pruneDecorations() keeps them while it is
+    // parked), so there is no overflow to share. The entry is only dropped
+    // once the chunk is published.
+    auto parked_blocks = findParked(key);
+    if (parked_blocks) {
+      chunk->restoreBlocks(ChunkBlocks(*parked_blocks));
+    } else if (!chunk_cache || !chunk_cache->load(key, *chunk, overflow)) {
+      chunk->generate(biome_map, overflow); // terrain and decorations
+      if (chunk_cache) chunk_cache->store(key, *chunk, overflow);
+    }
 
-    // Replay any saved player edits onto this freshly generated chunk before
-    // it gets meshed, then re-light so shadows/skylight reflect the changes.
+    // Before lighting: trees neighbours have already grown into this chunk,
+    // then any saved player edits, which win over everything generated.
+    const uint32_t seen = takeDecorations(key, *chunk);
     ChunkEdits ce;
     {
       std::lock_guard lk(edits_mutex);
@@ -181,39 +236,57 @@ void World::addChunk(int x, int z) {
       if (it != edits.end()) ce = it->second;
     }
     if (!ce.empty()) {
-      std::lock_guard dlk(chunk->data_mutex);
+      WriteLock dlk(chunk->data_mutex);
       for (const auto &[idx, block] : ce)
         chunk->setBlockLinear(idx, static_cast<BlockType>(block));
-      chunk->computeSkyLight();
-      chunk->computeBlockLight();
     }
+    chunk->finalize();
 
-    // Once generation is done, queue for meshing
-    mesh_pool.enqueue([this, chunk]() {
-      chunk->buildMeshData(this, renderer->getTextureManager());
-      {
-        WriteLock lock(chunks_mutex);
-        upload_queue.push(chunk);
-      }
-    });
+    // Hand this chunk's overhanging trees to their owners.
+    if (!overflow.empty()) shareDecorations(overflow);
+
+    // Move the chunk from pending into the world (even before meshing),
+    // unless it was unloaded while generating.
+    {
+      Lock lock(queue_mutex);
+      if (chunk->isCancelled()) return; // a re-added copy may own the key now
+      pending.erase(key);
+      chunks.insert(key, chunk);
+    }
+    if (parked_blocks) unparkChunk(key, parked_blocks.get());
 
-    // Safely add the chunk to the world (even before meshing)
+    // A neighbour may have shared decorations after takeDecorations() but
+    // before the insert above, when it couldn't see this chunk yet.
+    ChunkEdits late;
     {
-      WriteLock lock(chunks_mutex);
-      chunks.emplace(key, chunk);
+      std::lock_guard lk(decorations_mutex);
+      auto it = decorations.find(key);
+      if (it != decorations.end() && it->second.version != seen)
+        late = it->second.blocks;
     }
+    if (!late.empty()) placeDecorations(key, late);
 
     // If this chunk carries emitters (replayed torches), record that so the
     // relight machinery activates.
     if (chunk->hasEmitters())
       emitters_exist.store(true, std::memory_order_relaxed);
 
-    // If torches sit near this freshly streamed-in chunk, queue a cross-chunk
-    // relight (handled on the main thread) so light bleeds across the new border.
-    if (anyEmitterInRegion(key.x, key.z, 2)) {
-      std::lock_guard lk(relight_mutex);
-      relight_requests.push_back({key.x, key.z});
-    }
+    // Stitch light across the new borders (block light only near torches),
+    // then queue first meshes, so those see the stitched light. Chunks that
+    // are already meshed get rebuilt only if their light changed.
+    const bool block_light = anyEmitterInRegion(key.x, key.z, 1);
+    // Light jobs all run at the default priority, so in submission order.
+    light_pool.enqueue([this, key, priority, block_light]() {
+      std::vector<ChunkKey> dirty;
+      light_engine.stitchLight(key.x, key.z, block_light, dirty);
+      for (const auto &k : dirty) rebuildChunk(k.x, k.z);
+
+      // This chunk may complete its own or a neighbour's 3x3 neighbourhood.
+      for (int dz = -1; dz <= 1; ++dz)
+        for (int dx = -1; dx <= 1; ++dx)
+          if (auto c = getChunk(key.x + dx, key.z + dz))
+            queueFirstMesh(c, priority);
+    });
   });
 }
 
@@ -221,23 +294,6 @@ void World::update(float dt) {
   player->update(dt, this);
   cloud_time += dt;
 
-  // Drain cross-chunk relight requests queued as chunks stream in near torches.
-  if (emitters_exist.load(std::memory_order_relaxed)) {
-    std::vector<glm::ivec2> reqs;
-    {
-      std::lock_guard lk(relight_mutex);
-      reqs.swap(relight_requests);
-    }
-    if (!reqs.empty()) {
-      std::sort(reqs.begin(), reqs.end(),
-                [](auto &a, auto &b) { return a.x != b.x ? a.x < b.x : a.y < b.y; });
-      reqs.erase(std::unique(reqs.begin(), reqs.end(),
-                             [](auto &a, auto &b) { return a.x == b.x && a.y == b.y; }),
-                 reqs.end());
-      for (const auto &r : reqs) relightBlockRegion(r.x, r.y);
-    }
-  }
-
   glm::vec3 pos = player->getPosition();
   int current_chunk_x = static_cast<int>(floor(pos.x / kChunkWidth));
   int current_chunk_z = static_cast<int>(floor(pos.z / kChunkDepth));
@@ -247,16 +303,27 @@ void World::update(float dt) {
     last_chunk_z = current_chunk_z;
     updateLoadedChunks();
   }
+  unloadDistantChunks();
 
-  int uploads_this_frame = 0;
+  // Take this frame's uploads off the queue, then upload without holding the
+  // lock so mesh workers can keep queuing.
+  std::vector<std::shared_ptr<Chunk>> uploads;
   {
-    WriteLock lock(chunks_mutex);
-    while (!upload_queue.empty() && uploads_this_frame < kMaxUploadsPerFrame) {
-      upload_queue.front()->uploadGPU();
+    Lock lock(queue_mutex);
+    while (!upload_queue.empty() && uploads.size() < kMaxUploadsPerFrame) {
+      auto chunk = std::move(upload_queue.front());
       upload_queue.pop();
-      ++uploads_this_frame;
+      if (chunk->isCancelled()) continue; // unloaded since it was meshed
+      uploads.push_back(std::move(chunk));
     }
   }
+  for (auto &chunk : uploads)
+    chunk->uploadGPU();
+  uploads.clear();
+
+  // Free map tables (and the chunks only they still held) that no reader
+  // can see any more.
+  chunks.collect();
 }
 
 void World::preloadChunks() {
@@ -270,7 +337,7 @@ void World::preloadChunks() {
     int cx = last_chunk_x + offset.x;
     int cz = last_chunk_z + offset.y;
 
-    if (!getChunk(cx, cz)) {
+    if (!isChunkTracked(cx, cz)) {
       addChunk(cx, cz);
       ++chunksAdded;
     }
@@ -278,20 +345,14 @@ void World::preloadChunks() {
 }
 
 void World::updateLoadedChunks() {
-  const int r = g_settings.render_distance / kChunkWidth;
+  const int r = g_settings.render_distance / kChunkWidth + 1; // + border ring
   constexpr size_t MAX_ALLOWED_CHUNKS = 3000; // tweak as needed
 
   // Prevent runaway growth
-  {
-    ReadLock lock(chunks_mutex);
-    if (chunks.size() > MAX_ALLOWED_CHUNKS) {
-      return;
-    }
+  if (chunks.size() > MAX_ALLOWED_CHUNKS) {
+    return;
   }
 
-  robin_hood::unordered_set<ChunkKey, ChunkKeyHash> keep;
-  keep.reserve((2 * r + 1) * (2 * r + 1));
-
   int chunksAdded = 0;
 
   for (const auto &offset : spiral_offsets) {
@@ -301,41 +362,311 @@ void World::updateLoadedChunks() {
     if (offset.x * offset.x + offset.y * offset.y > r * r)
       continue;
 
-    keep.insert({cx, cz});
-
-    if (!getChunk(cx, cz) && chunksAdded < kMaxChunksPerFrame) {
+    if (chunksAdded < kMaxChunksPerFrame && !isChunkTracked(cx, cz)) {
       addChunk(cx, cz);
       ++chunksAdded;
     }
   }
 
-  // Unload chunks outside radius
-  std::vector<ChunkKey> to_remove;
+  // Loaded chunks beyond the unload radius are queued and dropped over the
+  // next frames, so a long move doesn't free hundreds of meshes in one.
+  unload_backlog.clear();
   {
-    WriteLock lock(chunks_mutex);
-    for (auto &[key, _] : chunks)
-      if (!keep.count(key))
+    ChunkMap::ReadGuard guard(chunks);
+    chunks.forEach([&](const ChunkKey &key, Chunk &) {
+      if (beyondUnloadRadius(key))
+        unload_backlog.push_back(key);
+    });
+  }
+
+  // Generation jobs that haven't produced a chunk yet are cheap to cancel,
+  // so those go at once.
+  {
+    Lock lock(queue_mutex);
+    std::vector<ChunkKey> to_remove;
+    for (auto &[key, _] : pending)
+      if (beyondUnloadRadius(key))
         to_remove.push_back(key);
-    for (auto &key : to_remove)
-      chunks.erase(key);
+    for (auto &key : to_remove) {
+      pending[key]->cancel();
+      pending.erase(key);
+    }
+  }
+
+  // A column may read a cell one chunk past the ones it is in.
+  biome_map.prune(last_chunk_x, last_chunk_z, r + kChunkUnloadMargin + 1);
+  pruneDecorations();
+}
+
+void World::unloadDistantChunks() {
+  if (unload_backlog.empty()) return;
+
+  std::vector<std::shared_ptr<Chunk>> unloaded;
+  {
+    Lock lock(queue_mutex);
+    while (!unload_backlog.empty() && unloaded.size() < kMaxUnloadsPerFrame) {
+      const ChunkKey key = unload_backlog.back();
+      unload_backlog.pop_back();
+      if (!beyondUnloadRadius(key)) continue; // the player came back
+      if (auto chunk = chunks.erase(key)) {
+        chunk->cancel();
+        unloaded.push_back(std::move(chunk));
+      }
+    }
   }
+
+  for (const auto &chunk : unloaded) {
+    const glm::ivec2 p = chunk->getPos();
+    chunk->releaseGPU();
+    parkChunk({p.x, p.y}, *chunk);
+  }
+}
+
+bool World::beyondUnloadRadius(const ChunkKey &key) const {
+  const int r = g_settings.render_distance / kChunkWidth + 1 + kChunkUnloadMargin;
+  const int dx = key.x - last_chunk_x;
+  const int dz = key.z - last_chunk_z;
+  return dx * dx + dz * dz > r * r;
 }
 
 void World::unloadChunk(int x, int z) {
-  WriteLock lock(chunks_mutex);
-  chunks.erase({x, z});
+  std::shared_ptr<Chunk> chunk;
+  {
+    Lock lock(queue_mutex);
+    chunk = chunks.erase({x, z});
+    if (!chunk) return;
+    chunk->cancel();
+  }
+  chunk->releaseGPU();
+  parkChunk({x, z}, *chunk);
 }
 
-void World::rebuildChunk(int cx, int cz) {
-  auto chunk = getChunk(cx, cz);
+void World::parkChunk(const ChunkKey &key, Chunk &chunk) {
+  const size_t budget = static_cast<size_t>(std::max(g_settings.unloaded_cache_mb, 0)) << 20;
+  if (budget == 0) return;
+
+  std::shared_ptr<const ChunkBlocks> blocks;
+  {
+    ReadLock lock(chunk.data_mutex);
+    blocks = std::make_shared<ChunkBlocks>(chunk.copyBlocks());
+  }
+  const size_t bytes = blocks->memoryUsage();
+
+  Lock lock(parked_mutex);
+  auto old = parked_index.find(key);
+  if (old != parked_index.end()) { // drop an older copy
+    parked_bytes -= old->second->bytes;
+    parked.erase(old->second);
+    parked_index.erase(old);
+  }
+  parked.push_front({key, std::move(blocks), bytes});
+  parked_index[key] = parked.begin();
+  parked_bytes += bytes;
+
+  while (parked_bytes > budget) {
+    parked_bytes -= parked.back().bytes;
+    parked_index.erase(parked.back().key);
+    parked.pop_back();
+  }
+}
+
+std::shared_ptr<const ChunkBlocks> World::findParked(const ChunkKey &key) {
+  Lock lock(parked_mutex);
+  auto it = parked_index.find(key);
+  return it == parked_index.end() ? nullptr : it->second->blocks;
+}
+
+void World::unparkChunk(const ChunkKey &key, const ChunkBlocks *blocks) {
+  Lock lock(parked_mutex);
+  auto it = parked_index.find(key);
+  // A newer copy may have been parked since `blocks` was found.
+  if (it == parked_index.end() || it->second->blocks.get() != blocks) return;
+  parked_bytes -= it->second->bytes;
+  parked.erase(it->second);
+  parked_index.erase(it);
+}
+
+bool World::isChunkTracked(int x, int z) const {
+  if (chunks.contains({x, z})) return true;
+  Lock lock(queue_mutex);
+  return pending.count({x, z}) > 0;
+}
+
+// ─── Cross-chunk decorations ───────────────────────────────────────────────
+
+namespace {
+
+// Merges one decoration block into `into` by the decorationReplaces() order.
+void mergeDecoration(ChunkEdits &into, uint32_t idx, BlockType type) {
+  auto [it, inserted] = into.emplace(idx, static_cast<uint8_t>(type));
+  if (!inserted && decorationReplaces(static_cast<BlockType>(it->second), type))
+    it->second = static_cast<uint8_t>(type);
+}
+
+} // namespace
+
+void World::shareDecorations(const std::vector<DecorationWrite> &writes) {
+  robin_hood::unordered_map<ChunkKey, ChunkEdits, ChunkKeyHash> by_chunk;
+  for (const auto &w : writes) {
+    const int cx = static_cast<int>(std::floor(static_cast<float>(w.pos.x) / kChunkWidth));
+    const int cz = static_cast<int>(std::floor(static_cast<float>(w.pos.z) / kChunkDepth));
+    const int lx = w.pos.x - cx * kChunkWidth;
+    const int lz = w.pos.z - cz * kChunkDepth;
+    mergeDecoration(by_chunk[{cx, cz}],
+                    lx + kChunkWidth * (lz + kChunkDepth * w.pos.y), w.type);
+  }
+
+  for (const auto &[key, blocks] : by_chunk) {
+    // Owners that aren't loaded yet pick the stash up when they generate;
+    // one whose generation is under way is covered by its version check.
+    bool loaded;
+    {
+      std::lock_guard lk(decorations_mutex);
+      PendingDecorations &stash = decorations[key];
+      for (const auto &[idx, block] : blocks)
+        mergeDecoration(stash.blocks, idx, static_cast<BlockType>(block));
+      ++stash.version;
+      loaded = chunks.contains(key);
+    }
+    if (loaded) placeDecorations(key, blocks);
+  }
+}
+
+void World::pruneDecorations() {
+  std::vector<ChunkKey> keys;
+  {
+    std::lock_guard lk(decorations_mutex);
+    keys.reserve(decorations.size());
+    for (const auto &[key, _] : decorations) keys.push_back(key);
+  }
+
+  // A stash is only needed while its chunk or a neighbour that spilled into
+  // it is loaded, generating or parked. Once none is, every neighbour shares
+  // its overflow again when it comes back (generated or from the chunk
+  // cache), so the stash would be rebuilt anyway.
+  std::vector<ChunkKey> stale;
+  {
+    Lock lock(queue_mutex);
+    Lock parked_lock(parked_mutex);
+    for (const ChunkKey &key : keys) {
+      bool needed = false;
+      for (int dz = -1; dz <= 1 && !needed; ++dz)
+        for (int dx = -1; dx <= 1 && !needed; ++dx) {
+          const ChunkKey n{key.x + dx, key.z + dz};
+          needed = chunks.contains(n) || pending.count(n) || parked_index.count(n);
+        }
+      if (!needed) stale.push_back(key);
+    }
+  }
+
+  std::lock_guard lk(decorations_mutex);
+  for (const ChunkKey &key : stale) decorations.erase(key);
+}
+
+uint32_t World::takeDecorations(const ChunkKey &key, Chunk &chunk) {
+  ChunkEdits blocks;
+  uint32_t version;
+  {
+    std::lock_guard lk(decorations_mutex);
+    auto it = decorations.find(key);
+    if (it == decorations.end()) return 0;
+    blocks = it->second.blocks;
+    version = it->second.version;
+  }
+  WriteLock lock(chunk.data_mutex);
+  for (const auto &[idx, block] : blocks) {
+    const BlockType type = static_cast<BlockType>(block);
+    if (decorationReplaces(chunk.atLinear(idx), type))
+      chunk.setBlockLinear(idx, type);
+  }
+  return version;
+}
+
+void World::placeDecorations(const ChunkKey &key, const ChunkEdits &blocks) {
+  auto chunk = getChunk(key.x, key.z);
   if (!chunk) return;
-  mesh_pool.enqueue([this, chunk]() {
-    chunk->buildMeshData(this, renderer->getTextureManager());
-    WriteLock lock(chunks_mutex);
-    upload_queue.push(chunk);
+
+  std::vector<LightEngine::BlockChange> changed;
+  {
+    // setBlockAt() records its edit under the chunk's write lock, so holding
+    // it here means every edit already made to this chunk is in `edits`.
+    WriteLock lock(chunk->data_mutex);
+    ChunkEdits player_edits;
+    {
+      std::lock_guard lk(edits_mutex);
+      auto it = edits.find(key);
+      if (it != edits.end()) player_edits = it->second;
+    }
+    for (const auto &[idx, block] : blocks) {
+      const BlockType type = static_cast<BlockType>(block);
+      const BlockType old_type = chunk->atLinear(idx);
+      if (player_edits.count(idx) || !decorationReplaces(old_type, type))
+        continue;
+      chunk->setBlockLinear(idx, type);
+      const int column = idx % (kChunkWidth * kChunkDepth);
+      changed.push_back({{key.x * kChunkWidth + column % kChunkWidth,
+                          static_cast<int>(idx / (kChunkWidth * kChunkDepth)),
+                          key.z * kChunkDepth + column / kChunkWidth},
+                         old_type});
+    }
+  }
+  if (changed.empty()) return;
+
+  // Same as a player edit, except that chunks still waiting on the writer for
+  // their first mesh skip the rebuild (see rebuildChunk()). All the blocks
+  // are in one chunk, so they relight in a single region.
+  light_pool.enqueue([this, changed = std::move(changed)]() {
+    std::vector<ChunkKey> dirty;
+    light_engine.blocksChanged(changed.data(), changed.size(), dirty);
+    std::sort(dirty.begin(), dirty.end(), [](const ChunkKey &a, const ChunkKey &b) {
+      return a.x != b.x ? a.x < b.x : a.z < b.z;
+    });
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+    for (const auto &k : dirty) rebuildChunk(k.x, k.z);
   });
 }
 
+void World::queueFirstMesh(const std::shared_ptr<Chunk> &chunk, int priority) {
+  if (chunk->getState() != ChunkState::Lit) return;
+  const glm::ivec2 pos = chunk->getPos();
+  for (int dz = -1; dz <= 1; ++dz)
+    for (int dx = -1; dx <= 1; ++dx) {
+      if (dx == 0 && dz == 0) continue;
+      auto n = getChunk(pos.x + dx, pos.y + dz);
+      if (!n || n->getState() < ChunkState::Lit) return;
+    }
+  // Several neighbours can arrive at once; only one of them gets to queue it.
+  if (chunk->advanceState(ChunkState::Lit, ChunkState::Meshing))
+    requestMesh(chunk, priority);
+}
+
+void World::requestMesh(const std::shared_ptr<Chunk> &chunk, int priority) {
+  if (chunk->addMeshRequest() != 0) return; // a job is already queued/running
+
+  mesh_pool.enqueue([this, chunk]() {
+    // Requests that arrive mid-build may have missed the snapshot, so build
+    // again until a pass completes with no new ones.
+    uint32_t seen;
+    do {
+      if (chunk->isCancelled()) return;
+      seen = chunk->meshRequests();
+      chunk->buildMeshData(this, renderer->getTextureManager());
+      chunk->setState(ChunkState::Meshed);
+    } while (!chunk->finishMeshRequests(seen));
+
+    Lock lock(queue_mutex);
+    if (!chunk->isCancelled()) upload_queue.push(chunk);
+  }, priority);
+}
+
+void World::rebuildChunk(int cx, int cz) {
+  auto chunk = getChunk(cx, cz);
+  // Not meshed yet: its first mesh will already see the change.
+  if (!chunk || chunk->getState() < ChunkState::Meshing) return;
+  // Edits remesh ahead of all streaming work.
+  requestMesh(chunk, -1);
+}
+
 bool World::anyEmitterInRegion(int ccx, int ccz, int radius) const {
   if (!emitters_exist.load(std::memory_order_relaxed)) return false;
   for (int cx = ccx - radius; cx <= ccx + radius; ++cx)
@@ -346,96 +677,6 @@ bool World::anyEmitterInRegion(int ccx, int ccz, int radius) const {
   return false;
 }
 
-// Recompute block light over a 5x5 chunk box (so torches up to 2 chunks away
-// are accounted for) into a temp buffer, then persist the inner 3x3 and remesh
-// it. Clearing + reflooding makes both placement and removal correct, and light
-// crosses chunk borders. Runs on the main thread.
-void World::relightBlockRegion(int ccx, int ccz) {
-  constexpr int KEEP = 1;    // chunks we write back
-  constexpr int COMPUTE = 2; // chunks we flood
-  constexpr int SPAN = 2 * COMPUTE + 1;
-  const int W = SPAN * kChunkWidth;
-  const int D = SPAN * kChunkDepth;
-  const int H = kChunkHeight;
-
-  // Snapshot the box's chunks once (nulls = unloaded → treated as opaque).
-  std::shared_ptr<Chunk> grid[SPAN][SPAN];
-  for (int i = 0; i < SPAN; ++i)
-    for (int j = 0; j < SPAN; ++j)
-      grid[i][j] = getChunk(ccx - COMPUTE + i, ccz - COMPUTE + j);
-
-  auto lidx = [&](int bx, int y, int bz) {
-    return static_cast<size_t>(bx) +
-           W * (static_cast<size_t>(bz) + static_cast<size_t>(D) * y);
-  };
-  std::vector<uint8_t> light(static_cast<size_t>(W) * D * H, 0);
-
-  // Opacity of a box-local voxel (box coords are always >= 0).
-  auto opacityAt = [&](int bx, int y, int bz) -> uint8_t {
-    if (y < 0 || y >= H) return 15;
-    const auto &c = grid[bx / kChunkWidth][bz / kChunkDepth];
-    if (!c) return 15;
-    return skyLightOpacity(c->at(bx % kChunkWidth, y, bz % kChunkDepth));
-  };
-
-  // Seed from every emitter in the box.
-  std::queue<std::tuple<int, int, int>> q;
-  for (int i = 0; i < SPAN; ++i)
-    for (int j = 0; j < SPAN; ++j) {
-      const auto &c = grid[i][j];
-      if (!c || !c->hasEmitters()) continue;
-      for (int y = 0; y < H; ++y)
-        for (int lz = 0; lz < kChunkDepth; ++lz)
-          for (int lx = 0; lx < kChunkWidth; ++lx) {
-            uint8_t emit = blockLightEmission(c->at(lx, y, lz));
-            if (!emit) continue;
-            int bx = i * kChunkWidth + lx;
-            int bz = j * kChunkDepth + lz;
-            size_t k = lidx(bx, y, bz);
-            if (emit > light[k]) { light[k] = emit; q.push({bx, y, bz}); }
-          }
-    }
-
-  // Flood fill within the box.
-  static constexpr int DX[6] = {-1, 1, 0, 0, 0, 0};
-  static constexpr int DY[6] = {0, 0, -1, 1, 0, 0};
-  static constexpr int DZ[6] = {0, 0, 0, 0, -1, 1};
-  while (!q.empty()) {
-    auto [bx, by, bz] = q.front();
-    q.pop();
-    uint8_t l = light[lidx(bx, by, bz)];
-    if (l <= 1) continue;
-    for (int d = 0; d < 6; ++d) {
-      int nx = bx + DX[d], ny = by + DY[d], nz = bz + DZ[d];
-      if (nx < 0 || nx >= W || ny < 0 || ny >= H || nz < 0 || nz >= D) continue;
-      uint8_t op = opacityAt(nx, ny, nz);
-      if (op >= 15) continue;
-      uint8_t cost = 1 + op;
-      uint8_t nl = (l > cost) ? static_cast<uint8_t>(l - cost) : 0;
-      if (nl == 0) continue;
-      size_t k = lidx(nx, ny, nz);
-      if (nl > light[k]) { light[k] = nl; q.push({nx, ny, nz}); }
-    }
-  }
-
-  // Persist the inner KEEP region back into the chunks, then remesh them.
-  for (int i = COMPUTE - KEEP; i <= COMPUTE + KEEP; ++i)
-    for (int j = COMPUTE - KEEP; j <= COMPUTE + KEEP; ++j) {
-      const auto &c = grid[i][j];
-      if (!c) continue;
-      {
-        std::lock_guard lock(c->data_mutex);
-        for (int y = 0; y < H; ++y)
-          for (int lz = 0; lz < kChunkDepth; ++lz)
-            for (int lx = 0; lx < kChunkWidth; ++lx)
-              c->setBlockLightLinear(
-                  lx + kChunkWidth * (lz + kChunkDepth * y),
-                  light[lidx(i * kChunkWidth + lx, y, j * kChunkDepth + lz)]);
-      }
-      rebuildChunk(ccx - COMPUTE + i, ccz - COMPUTE + j);
-    }
-}
-
 void World::setBlockAt(const glm::ivec3& worldPos, BlockType type) {
   int bx = worldPos.x, by = worldPos.y, bz = worldPos.z;
   if (by < 0 || by >= kChunkHeight) return;
@@ -451,42 +692,31 @@ void World::setBlockAt(const glm::ivec3& worldPos, BlockType type) {
 
   BlockType oldType;
   {
-    std::lock_guard lock(chunk->data_mutex);
+    WriteLock lock(chunk->data_mutex);
     oldType = chunk->at(lx, by, lz);
-    chunk->at(lx, by, lz) = type;
-    chunk->computeSkyLight(); // re-propagate sky light after block change
+    if (oldType == type) return;
+    chunk->setBlock(lx, by, lz, type);
     // Keep the emitter count in sync for this single-block change.
     chunk->adjustEmitterCount((blockLightEmission(type) > 0 ? 1 : 0) -
                               (blockLightEmission(oldType) > 0 ? 1 : 0));
-  }
-  if (blockLightEmission(type) > 0)
-    emitters_exist.store(true, std::memory_order_relaxed);
 
-  // Record the delta so it survives save/load (breaking a block records AIR).
-  {
+    // Record the delta so it survives save/load (breaking a block records
+    // AIR). Still under the chunk lock, so placeDecorations() can't slip a
+    // tree block in between the write and the record.
     uint32_t idx = lx + kChunkWidth * (lz + kChunkDepth * by);
     std::lock_guard lk(edits_mutex);
     edits[{cx, cz}][idx] = static_cast<uint8_t>(type);
   }
+  if (blockLightEmission(type) > 0)
+    emitters_exist.store(true, std::memory_order_relaxed);
 
-  // Block light: if a torch is involved or nearby, run the cross-chunk relight
-  // (recomputes + remeshes the 3x3 around the edit). Otherwise take the cheap
-  // intra-chunk path and rebuild the edited chunk (+ edge neighbors).
-  bool emitterInvolved =
-      blockLightEmission(type) > 0 || blockLightEmission(oldType) > 0;
-  if (emitterInvolved || anyEmitterInRegion(cx, cz, 2)) {
-    relightBlockRegion(cx, cz);
-  } else {
-    {
-      std::lock_guard lock(chunk->data_mutex);
-      chunk->computeBlockLight();
-    }
-    rebuildChunk(cx, cz);
-    if (lx == 0)              rebuildChunk(cx - 1, cz);
-    if (lx == kChunkWidth-1)  rebuildChunk(cx + 1, cz);
-    if (lz == 0)              rebuildChunk(cx, cz - 1);
-    if (lz == kChunkDepth-1)  rebuildChunk(cx, cz + 1);
-  }
+  // Relight off the main thread; the job remeshes every chunk it touched
+  // (the edited one always), so the new block shows up already lit.
+  light_pool.enqueue([this, worldPos, oldType]() {
+    std::vector<ChunkKey> dirty;
+    light_engine.blockChanged(worldPos, oldType, dirty);
+    for (const auto &k : dirty) rebuildChunk(k.x, k.z);
+  });
 }
 
 bool World::isChunkInFrustum(const glm::vec4 planes[6], const glm::vec3 &min,
@@ -508,31 +738,35 @@ bool World::isChunkInFrustum(const glm::vec4 planes[6], const glm::vec3 &min,
 
 void World::render(glm::mat4 &view, glm::mat4 &projection, float timeOfDay,
                    int viewportWidth, int viewportHeight) {
-  ReadLock lock(chunks_mutex);
+  ChunkMap::ReadGuard guard(chunks);
 
   glm::mat4 viewProj = projection * view;
 
   glm::vec4 planes[6];
   player->getCamera().getFrustumPlanes(planes, viewProj);
+  std::copy(planes, planes + 6, frustum_planes);
+  has_frustum = true;
 
+  std::vector<Chunk *> loadedChunks;
   std::vector<Chunk *> visibleChunks;
+  loadedChunks.reserve(chunks.size());
   visibleChunks.reserve(chunks.size());
 
-  for (const auto &[key, chunk] : chunks) {
-    if (!chunk) continue;
+  chunks.forEach([&](const ChunkKey &key, Chunk &chunk) {
+    loadedChunks.push_back(&chunk);
     glm::vec3 min = {key.x * kChunkWidth, 0.0f, key.z * kChunkDepth};
     glm::vec3 max = {(key.x + 1) * kChunkWidth,
                      static_cast<float>(kChunkHeight),
                      (key.z + 1) * kChunkDepth};
 
     if (isChunkInFrustum(planes, min, max)) {
-      visibleChunks.push_back(chunk.get());
+      visibleChunks.push_back(&chunk);
     }
-  }
+  });
 
   // Shadow pass: render depth from sun's perspective (uses all loaded chunks
   // so that off-screen geometry can still cast shadows into view)
-  renderer->shadowPass(chunks, player->getPosition(), timeOfDay,
+  renderer->shadowPass(loadedChunks, player->getPosition(), timeOfDay,
                        viewportWidth, viewportHeight);
 
   // Sky must be drawn before world geometry (it uses GL_LEQUAL depth and writes
@@ -549,19 +783,14 @@ void World::render(glm::mat4 &view, glm::mat4 &projection, float timeOfDay,
 }
 
 std::shared_ptr<Chunk> World::getChunk(int x, int z) {
-  return std::const_pointer_cast<Chunk>(std::as_const(*this).getChunk(x, z));
+  return chunks.get({x, z});
 }
 
 std::shared_ptr<const Chunk> World::getChunk(int x, int z) const {
-  ReadLock lock(chunks_mutex);
-  auto it = chunks.find({x, z});
-  if (it == chunks.end())
-    return nullptr;
-  return it->second;
+  return chunks.get({x, z});
 }
 
 size_t World::getChunkCount() const {
-  ReadLock lock(chunks_mutex);
   return chunks.size();
 }
 
@@ -577,7 +806,8 @@ BlockType World::getBlockAt(const glm::vec3& worldPos) const {
   int cx = static_cast<int>(std::floor(static_cast<float>(bx) / kChunkWidth));
   int cz = static_cast<int>(std::floor(static_cast<float>(bz) / kChunkDepth));
 
-  auto chunk = getChunk(cx, cz);
+  ChunkMap::ReadGuard guard(chunks);
+  Chunk *chunk = chunks.find({cx, cz});
   if (!chunk) {
     return BlockType::AIR;
   }
@@ -585,6 +815,8 @@ BlockType World::getBlockAt(const glm::vec3& worldPos) const {
   int lx = bx - cx * kChunkWidth;
   int lz = bz - cz * kChunkDepth;
 
+  // Decorations are written into loaded chunks from worker threads.
+  ReadLock lock(chunk->data_mutex);
   return chunk->safeAt(lx, by, lz);
 }
 
@@ -598,8 +830,10 @@ uint8_t World::getSkyLightAt(const glm::ivec3 &p) const {
   if (p.y < 0 || p.y >= kChunkHeight) return 15;
   int cx = static_cast<int>(std::floor(static_cast<float>(p.x) / kChunkWidth));
   int cz = static_cast<int>(std::floor(static_cast<float>(p.z) / kChunkDepth));
-  auto chunk = getChunk(cx, cz);
+  ChunkMap::ReadGuard guard(chunks);
+  Chunk *chunk = chunks.find({cx, cz});
   if (!chunk) return 0;
+  ReadLock lock(chunk->data_mutex);
   return chunk->safeSkyLight(p.x - cx * kChunkWidth, p.y, p.z - cz * kChunkDepth);
 }
 
@@ -607,8 +841,10 @@ uint8_t World::getBlockLightAt(const glm::ivec3 &p) const {
   if (p.y < 0 || p.y >= kChunkHeight) return 0;
   int cx = static_cast<int>(std::floor(static_cast<float>(p.x) / kChunkWidth));
   int cz = static_cast<int>(std::floor(static_cast<float>(p.z) / kChunkDepth));
-  auto chunk = getChunk(cx, cz);
+  ChunkMap::ReadGuard guard(chunks);
+  Chunk *chunk = chunks.find({cx, cz});
   if (!chunk) return 0;
+  ReadLock lock(chunk->data_mutex);
   return chunk->safeBlockLight(p.x - cx * kChunkWidth, p.y, p.z - cz * kChunkDepth);
 }
 
@@ -734,6 +970,10 @@ void World::setLoadedPlayer(const WorldSave::PlayerData &p) {
   has_loaded_player = true;
 }
 
+void World::enableChunkCache(const std::string &dir, size_t max_bytes) {
+  chunk_cache = std::make_unique<ChunkCache>(dir, max_bytes);
+}
+
 WorldEdits World::snapshotEdits() const {
   std::lock_guard lk(edits_mutex);
   return edits;